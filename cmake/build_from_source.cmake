@@ -57,8 +57,15 @@ set(EXECUTORCH_BUILD_EXTENSION_NAMED_DATA_MAP ON CACHE BOOL "Build named data ma
 set(EXECUTORCH_BUILD_EXTENSION_RUNNER_UTIL ON CACHE BOOL "Build runner util extension" FORCE)
 set(EXECUTORCH_BUILD_EXTENSION_DATA_LOADER ON CACHE BOOL "Build data loader extension" FORCE)
 set(EXECUTORCH_BUILD_EXTENSION_TENSOR ON CACHE BOOL "Build tensor extension" FORCE)
+set(EXECUTORCH_BUILD_EXTENSION_THREADPOOL ON CACHE BOOL "Build threadpool extension" FORCE)
 set(EXECUTORCH_BUILD_KERNELS_PORTABLE ON CACHE BOOL "Build portable kernels" FORCE)
-set(EXECUTORCH_BUILD_KERNELS_OPTIMIZED OFF CACHE BOOL "Build optimized kernels" FORCE)
+if(ET_BUILD_OPTIMIZED_KERNELS)
+    set(EXECUTORCH_BUILD_KERNELS_OPTIMIZED ON CACHE BOOL "Build optimized kernels" FORCE)
+    set(EXECUTORCH_BUILD_KERNELS_QUANTIZED ON CACHE BOOL "Build quantized kernels" FORCE)
+else()
+    set(EXECUTORCH_BUILD_KERNELS_OPTIMIZED OFF CACHE BOOL "Build optimized kernels" FORCE)
+    set(EXECUTORCH_BUILD_KERNELS_QUANTIZED OFF CACHE BOOL "Build quantized kernels" FORCE)
+endif()
 set(EXECUTORCH_BUILD_DEVTOOLS OFF CACHE BOOL "Build devtools" FORCE)
 set(EXECUTORCH_BUILD_SDK OFF CACHE BOOL "Build SDK" FORCE)
 set(EXECUTORCH_BUILD_TESTS OFF CACHE BOOL "Build tests" FORCE)
@@ -71,6 +78,7 @@ message(STATUS "ET_BUILD_COREML input: ${ET_BUILD_COREML}")
 message(STATUS "ET_BUILD_MPS input: ${ET_BUILD_MPS}")
 message(STATUS "ET_BUILD_VULKAN input: ${ET_BUILD_VULKAN}")
 message(STATUS "ET_BUILD_QNN input: ${ET_BUILD_QNN}")
+message(STATUS "ET_BUILD_OPTIMIZED_KERNELS input: ${ET_BUILD_OPTIMIZED_KERNELS}")
 
 if(ET_BUILD_XNNPACK)
     set(EXECUTORCH_BUILD_XNNPACK ON CACHE BOOL "Build XNNPACK backend" FORCE)
@@ -423,6 +431,97 @@ message(STATUS "  EXECUTORCH_BUILD_COREML: ${EXECUTORCH_BUILD_COREML}")
 message(STATUS "  EXECUTORCH_BUILD_MPS: ${EXECUTORCH_BUILD_MPS}")
 add_subdirectory(${executorch_SOURCE_DIR} ${executorch_BINARY_DIR})
 
+# ============================================================================
+# Selective Build
+# ============================================================================
+# When ET_SELECTIVE_BUILD_OPS / ET_SELECTIVE_BUILD_MODELS are set, generate an
+# operator library that registers only those portable kernels (upstream
+# gen_selected_ops / generate_bindings_for_kernels / gen_operators_lib) and
+# link it instead of portable_ops_lib. Operators of .pte files are extracted at
+# configure time by scripts/pte-oplist.py; editing a listed model re-runs
+# configure. Delegated subgraphs do not need CPU kernels and are not listed.
+
+set(_selected_ops "")
+if(ET_SELECTIVE_BUILD_OPS)
+    string(REPLACE "," ";" _selected_ops "${ET_SELECTIVE_BUILD_OPS}")
+endif()
+
+if(ET_SELECTIVE_BUILD_MODELS)
+    string(REPLACE "," ";" _selective_models "${ET_SELECTIVE_BUILD_MODELS}")
+    foreach(_model ${_selective_models})
+        if(NOT EXISTS "${_model}")
+            message(FATAL_ERROR "ET_SELECTIVE_BUILD_MODELS: model not found: ${_model}")
+        endif()
+    endforeach()
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${_selective_models})
+
+    execute_process(
+        COMMAND ${_original_python} ${CMAKE_CURRENT_LIST_DIR}/../scripts/pte-oplist.py
+            --format csv ${_selective_models}
+        OUTPUT_VARIABLE _model_ops
+        ERROR_VARIABLE _model_ops_error
+        RESULT_VARIABLE _model_ops_result
+        OUTPUT_STRIP_TRAILING_WHITESPACE
+    )
+    if(NOT _model_ops_result EQUAL 0)
+        message(FATAL_ERROR "Failed to extract operators from models: ${_model_ops_error}")
+    endif()
+    string(REPLACE "," ";" _model_ops "${_model_ops}")
+    list(APPEND _selected_ops ${_model_ops})
+endif()
+
+list(TRANSFORM _selected_ops STRIP)
+list(REMOVE_ITEM _selected_ops "")
+list(REMOVE_DUPLICATES _selected_ops)
+list(SORT _selected_ops)
+
+set(EXECUTORCH_FFI_SELECTIVE_BUILD FALSE)
+if(ET_SELECTIVE_BUILD_OPS OR ET_SELECTIVE_BUILD_MODELS)
+    if(ET_BUILD_OPTIMIZED_KERNELS)
+        # The optimized ops library is itself generated from a merged yaml with
+        # one kernel per op; a second selective registration would collide.
+        message(FATAL_ERROR "Selective build selects from the portable kernels and "
+            "cannot be combined with ET_BUILD_OPTIMIZED_KERNELS")
+    endif()
+    if(ET_BUILD_STATIC_LIB)
+        # The static library's link interface names the generated ops library,
+        # which is neither installed nor exported with executorch_ffi_targets,
+        # so the installed package could not resolve it.
+        message(FATAL_ERROR "Selective build cannot be combined with ET_BUILD_STATIC_LIB: "
+            "the generated executorch_ffi_selected_ops library is not part of the installed package")
+    endif()
+    if(NOT _selected_ops)
+        message(FATAL_ERROR "Selective build requested but no operators were found")
+    endif()
+
+    list(LENGTH _selected_ops _selected_ops_count)
+    message(STATUS "Selective build: registering ${_selected_ops_count} operators")
+    foreach(_op ${_selected_ops})
+        message(STATUS "    ${_op}")
+    endforeach()
+    string(JOIN "," _selected_ops_csv ${_selected_ops})
+
+    set(EXECUTORCH_ROOT ${executorch_SOURCE_DIR})
+    include(${executorch_SOURCE_DIR}/tools/cmake/Utils.cmake)
+    include(${executorch_SOURCE_DIR}/tools/cmake/Codegen.cmake)
+
+    gen_selected_ops(
+        LIB_NAME "executorch_ffi_selected_ops"
+        ROOT_OPS "${_selected_ops_csv}"
+        INCLUDE_ALL_OPS "OFF"
+    )
+    generate_bindings_for_kernels(
+        LIB_NAME "executorch_ffi_selected_ops"
+        FUNCTIONS_YAML ${executorch_SOURCE_DIR}/kernels/portable/functions.yaml
+    )
+    gen_operators_lib(
+        LIB_NAME "executorch_ffi_selected_ops"
+        KERNEL_LIBS portable_kernels
+        DEPS executorch_core
+    )
+    set(EXECUTORCH_FFI_SELECTIVE_BUILD TRUE)
+endif()
+
 # ============================================================================
 # Set Include and Library Paths
 # ============================================================================
@@ -447,10 +546,43 @@ set(EXECUTORCH_LIBRARIES
     extension_module_static
     extension_data_loader
     extension_tensor
-    portable_ops_lib
-    portable_kernels
 )
 
+# Kernel libraries.
+# Registration precedence: optimized_native_cpu_ops_lib is generated upstream
+# from optimized.yaml merged over the portable functions.yaml, so it registers
+# exactly one kernel per op - the optimized one where it exists, the portable
+# one otherwise. It therefore REPLACES portable_ops_lib; linking both would
+# register every portable op twice and fail kernel registration at startup.
+# The quantized ops live in their own namespace (quantized_decomposed::*) and
+# never collide with either library.
+# A missing optimized library is an error rather than a portable fallback:
+# the variant name and et_kernel_library() would still report "optimized".
+if(ET_BUILD_OPTIMIZED_KERNELS AND NOT TARGET optimized_native_cpu_ops_lib)
+    message(FATAL_ERROR "ET_BUILD_OPTIMIZED_KERNELS=ON but the optimized_native_cpu_ops_lib target was not "
+                        "built by ExecuTorch; configure with ET_BUILD_OPTIMIZED_KERNELS=OFF for portable kernels")
+endif()
+if(ET_BUILD_OPTIMIZED_KERNELS)
+    list(APPEND EXECUTORCH_LIBRARIES
+        optimized_native_cpu_ops_lib
+        optimized_kernels
+        portable_kernels
+    )
+    if(TARGET quantized_ops_lib)
+        list(APPEND EXECUTORCH_LIBRARIES quantized_ops_lib quantized_kernels)
+    endif()
+elseif(EXECUTORCH_FFI_SELECTIVE_BUILD)
+    list(APPEND EXECUTORCH_LIBRARIES
+        executorch_ffi_selected_ops
+        portable_kernels
+    )
+else()
+    list(APPEND EXECUTORCH_LIBRARIES
+        portable_ops_lib
+        portable_kernels
+    )
+endif()
+
 # Extension libraries (conditionally linked if targets exist)
 if(TARGET extension_flat_tensor)
     list(APPEND EXECUTORCH_LIBRARIES extension_flat_tensor)
@@ -459,6 +591,14 @@ if(TARGET extension_named_data_map)
     list(APPEND EXECUTORCH_LIBRARIES extension_named_data_map)
 endif()
 
+# Shared CPU threadpool (XNNPACK, optimized kernels). The FFI resizes it for
+# per-model thread counts (ET_HAS_THREADPOOL).
+set(EXECUTORCH_FFI_HAS_THREADPOOL FALSE)
+if(TARGET extension_threadpool)
+    list(APPEND EXECUTORCH_LIBRARIES extension_threadpool)
+    set(EXECUTORCH_FFI_HAS_THREADPOOL TRUE)
+endif()
+
 # Backend libraries
 if(ET_BUILD_XNNPACK AND TARGET xnnpack_backend)
     list(APPEND EXECUTORCH_LIBRARIES xnnpack_backend)
@@ -0,0 +1,174 @@
+# optimization.cmake
+# Whole-program optimization for source builds: x86-64 ISA level, LTO and
+# two-stage PGO
+#
+# Must be included BEFORE ExecuTorch is added (build_from_source.cmake) so the
+# flags apply to the FFI wrapper, the ExecuTorch runtime, the kernel libraries
+# and the backends alike - cross-library inlining of the interpreter loop into
+# the kernels is where most of the gain comes from.
+#
+# PGO flow (see scripts/build-pgo.sh, which runs all of it):
+#   1. Configure with ET_PGO=GENERATE and build -> instrumented library
+#   2. cmake --build <dir> --target pgo-train  (runs ET_PGO_TRAINING_COMMAND)
+#   3. cmake --build <dir> --target pgo-merge  (Clang only: .profraw -> .profdata)
+#   4. Re-configure the SAME build directory with ET_PGO=USE and rebuild
+#
+# GCC keys its .gcda files on object file paths, so both stages must use the
+# same build directory. Clang does not care, but the script does the same.
+
+# ============================================================================
+# x86-64 Microarchitecture Level
+# ============================================================================
+# The portable kernels are plain C++ loops, so the ISA the compiler may assume
+# decides whether they get vectorized with SSE2 or AVX2/AVX-512. XNNPACK
+# already dispatches its microkernels at runtime and is unaffected in that
+# respect. ET_X86_64_LEVEL was validated in CMakeLists.txt.
+
+if(ET_X86_64_LEVEL)
+    if(MSVC)
+        # MSVC has no -march levels; map to the closest /arch switch
+        if(ET_X86_64_LEVEL STREQUAL "v2")
+            add_compile_options(/arch:SSE4.2)
+        elseif(ET_X86_64_LEVEL STREQUAL "v3")
+            add_compile_options(/arch:AVX2)
+        else()
+            add_compile_options(/arch:AVX512)
+        endif()
+    else()
+        # GCC 11+ / Clang 12+
+        add_compile_options(-march=x86-64-${ET_X86_64_LEVEL})
+    endif()
+    message(STATUS "  x86-64 level: ${ET_X86_64_LEVEL}")
+endif()
+
+# ============================================================================
+# Link-Time Optimization
+# ============================================================================
+
+if(ET_ENABLE_LTO)
+    include(CheckIPOSupported)
+    check_ipo_supported(RESULT _ipo_supported OUTPUT _ipo_output LANGUAGES C CXX)
+    if(_ipo_supported)
+        # Directory-scope default: picked up by every target created after this
+        # point, including the ExecuTorch subdirectory. CMake switches to the
+        # LTO-aware archiver (gcc-ar / llvm-ar) for static libraries itself.
+        set(CMAKE_INTERPROCEDURAL_OPTIMIZATION ON)
+        message(STATUS "  LTO: enabled")
+    else()
+        message(WARNING "LTO requested but not supported by this toolchain: ${_ipo_output}")
+    endif()
+endif()
+
+# ============================================================================
+# Profile-Guided Optimization
+# ============================================================================
+
+string(TOUPPER "${ET_PGO}" _pgo_mode)
+if(_pgo_mode STREQUAL "" OR _pgo_mode STREQUAL "OFF")
+    return()
+endif()
+
+if(NOT _pgo_mode MATCHES "^(GENERATE|USE)$")
+    message(FATAL_ERROR "ET_PGO must be OFF, GENERATE or USE (got '${ET_PGO}')")
+endif()
+
+if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    set(_pgo_compiler "clang")
+elseif(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+    set(_pgo_compiler "gcc")
+else()
+    message(FATAL_ERROR "ET_PGO requires GCC or Clang (got ${CMAKE_CXX_COMPILER_ID})")
+endif()
+
+file(MAKE_DIRECTORY "${ET_PGO_PROFILE_DIR}")
+set(_pgo_profdata "${ET_PGO_PROFILE_DIR}/merged.profdata")
+
+if(_pgo_mode STREQUAL "GENERATE")
+    # Instrumented build: every process that loads the library writes its
+    # counters to ET_PGO_PROFILE_DIR on exit.
+    add_compile_options("-fprofile-generate=${ET_PGO_PROFILE_DIR}")
+    add_link_options("-fprofile-generate=${ET_PGO_PROFILE_DIR}")
+    if(_pgo_compiler STREQUAL "gcc")
+        # Counters are updated from XNNPACK / threadpool worker threads
+        add_compile_options(-fprofile-update=atomic)
+    endif()
+    message(STATUS "  PGO: GENERATE (profiles -> ${ET_PGO_PROFILE_DIR})")
+else()
+    if(_pgo_compiler STREQUAL "clang")
+        if(NOT EXISTS "${_pgo_profdata}")
+            message(FATAL_ERROR
+                "ET_PGO=USE but ${_pgo_profdata} does not exist.\n"
+                "Build with ET_PGO=GENERATE, run the pgo-train and pgo-merge targets first.")
+        endif()
+        add_compile_options(
+            "-fprofile-use=${_pgo_profdata}"
+            -Wno-profile-instr-unprofiled
+            -Wno-profile-instr-out-of-date
+            -Wno-backend-plugin
+        )
+        add_link_options("-fprofile-use=${_pgo_profdata}")
+    else()
+        file(GLOB_RECURSE _gcda_files "${ET_PGO_PROFILE_DIR}/*.gcda")
+        if(NOT _gcda_files)
+            message(FATAL_ERROR
+                "ET_PGO=USE but no .gcda profiles found in ${ET_PGO_PROFILE_DIR}.\n"
+                "Build with ET_PGO=GENERATE and run the pgo-train target first.")
+        endif()
+        # -fprofile-correction: counters from multi-threaded runs can be
+        # slightly inconsistent. Objects the training run never reached have
+        # no profile, which is expected and not worth a warning each.
+        add_compile_options(
+            "-fprofile-use=${ET_PGO_PROFILE_DIR}"
+            -fprofile-correction
+            -Wno-missing-profile
+        )
+        add_link_options("-fprofile-use=${ET_PGO_PROFILE_DIR}")
+    endif()
+    message(STATUS "  PGO: USE (profiles <- ${ET_PGO_PROFILE_DIR})")
+endif()
+
+# ----------------------------------------------------------------------------
+# pgo-train / pgo-merge helper targets
+# ----------------------------------------------------------------------------
+
+if(_pgo_mode STREQUAL "GENERATE")
+    if(ET_PGO_TRAINING_COMMAND)
+        separate_arguments(_pgo_training_command NATIVE_COMMAND "${ET_PGO_TRAINING_COMMAND}")
+        add_custom_target(pgo-train
+            COMMAND ${_pgo_training_command}
+            WORKING_DIRECTORY ${CMAKE_BINARY_DIR}
+            COMMENT "Running PGO training workload: ${ET_PGO_TRAINING_COMMAND}"
+            USES_TERMINAL
+        )
+        # The executorch_ffi target is defined after this file is included;
+        # the dependency is added in CMakeLists.txt.
+    endif()
+
+    if(_pgo_compiler STREQUAL "clang")
+        get_filename_component(_compiler_dir "${CMAKE_CXX_COMPILER}" DIRECTORY)
+        find_program(LLVM_PROFDATA_EXECUTABLE
+            NAMES llvm-profdata
+            HINTS ${_compiler_dir}
+        )
+        if(NOT LLVM_PROFDATA_EXECUTABLE AND APPLE)
+            execute_process(
+                COMMAND xcrun --find llvm-profdata
+                OUTPUT_VARIABLE LLVM_PROFDATA_EXECUTABLE
+                OUTPUT_STRIP_TRAILING_WHITESPACE
+                ERROR_QUIET
+            )
+        endif()
+        if(LLVM_PROFDATA_EXECUTABLE)
+            add_custom_target(pgo-merge
+                COMMAND ${CMAKE_COMMAND}
+                    -DLLVM_PROFDATA=${LLVM_PROFDATA_EXECUTABLE}
+                    -DPROFILE_DIR=${ET_PGO_PROFILE_DIR}
+                    -DOUTPUT=${_pgo_profdata}
+                    -P ${CMAKE_CURRENT_LIST_DIR}/pgo_merge.cmake
+                COMMENT "Merging PGO profiles into ${_pgo_profdata}"
+            )
+        else()
+            message(WARNING "llvm-profdata not found - merge .profraw files manually")
+        endif()
+    endif()
+endif()
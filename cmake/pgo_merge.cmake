@@ -0,0 +1,22 @@
+# pgo_merge.cmake
+# Script mode (cmake -P): merge Clang .profraw files into one .profdata
+#
+# Inputs: LLVM_PROFDATA, PROFILE_DIR, OUTPUT
+
+file(GLOB _profraw_files "${PROFILE_DIR}/*.profraw")
+if(NOT _profraw_files)
+    message(FATAL_ERROR
+        "No .profraw files in ${PROFILE_DIR} - run the pgo-train target "
+        "(or any workload using the instrumented library) first")
+endif()
+
+list(LENGTH _profraw_files _profraw_count)
+message(STATUS "Merging ${_profraw_count} profile(s) into ${OUTPUT}")
+
+execute_process(
+    COMMAND ${LLVM_PROFDATA} merge -output=${OUTPUT} ${_profraw_files}
+    RESULT_VARIABLE _merge_result
+)
+if(NOT _merge_result EQUAL 0)
+    message(FATAL_ERROR "llvm-profdata merge failed (${_merge_result})")
+endif()
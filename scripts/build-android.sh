@@ -7,6 +7,9 @@
 # - x86_64: xnnpack, xnnpack-vulkan (64-bit emulator)
 # - x86: xnnpack, xnnpack-vulkan (32-bit emulator)
 #
+# Every ABI also gets an xnnpack-optimized variant (optimized + quantized
+# CPU kernels instead of portable-only).
+#
 # Vulkan builds require glslc compiler (from Android NDK or Vulkan SDK)
 #
 # Usage: ./build-android.sh [VERSION]
@@ -64,11 +67,13 @@ check_vulkan() {
     return 1
 }
 
-# All variants to build: backends:vulkan
+# All variants to build: backends:vulkan:optimized
 # Define all variants - if Vulkan variant is listed and SDK is missing, build will fail
+# "optimized" variants link optimized + quantized CPU kernels instead of portable-only
 VARIANTS=(
-    "xnnpack:OFF"
-    "xnnpack-vulkan:ON"
+    "xnnpack:OFF:OFF"
+    "xnnpack-vulkan:ON:OFF"
+    "xnnpack-optimized:OFF:ON"
 )
 
 echo "============================================================"
@@ -112,7 +117,8 @@ build_variant() {
   local abi=$1
   local backends=$2
   local vulkan=$3
-  local build_type=$4
+  local optimized=$4
+  local build_type=$5
   local build_type_lower=$(echo "$build_type" | tr '[:upper:]' '[:lower:]')
   local build_dir="${PROJECT_DIR}/build-${PLATFORM}-${abi}-${backends}-${build_type_lower}"
   local artifact_name="libexecutorch_ffi-${PLATFORM}-${abi}-${backends}-${build_type_lower}.tar.gz"
@@ -120,7 +126,7 @@ build_variant() {
   echo ""
   echo "=== Building ${PLATFORM}-${abi}-${backends}-${build_type_lower} ==="
   echo "  Build directory: ${build_dir}"
-  echo "  Backends: XNNPACK=ON, Vulkan=${vulkan}"
+  echo "  Backends: XNNPACK=ON, Vulkan=${vulkan}, Optimized kernels=${optimized}"
 
   # Check Vulkan requirement
   if [ "$vulkan" = "ON" ]; then
@@ -147,6 +153,7 @@ build_variant() {
     -DET_BUILD_MPS=OFF \
     -DET_BUILD_VULKAN="${vulkan}" \
     -DET_BUILD_QNN=OFF \
+    -DET_BUILD_OPTIMIZED_KERNELS="${optimized}" \
     -DCMAKE_INSTALL_PREFIX="${build_dir}/install"
 
   # Build
@@ -187,9 +194,9 @@ for abi in "${ABIS[@]}"; do
   echo "============================================================"
 
   for variant in "${VARIANTS[@]}"; do
-    IFS=':' read -r backends vulkan <<< "$variant"
-    build_variant "$abi" "$backends" "$vulkan" "Release"
-    build_variant "$abi" "$backends" "$vulkan" "Debug"
+    IFS=':' read -r backends vulkan optimized <<< "$variant"
+    build_variant "$abi" "$backends" "$vulkan" "$optimized" "Release"
+    build_variant "$abi" "$backends" "$vulkan" "$optimized" "Debug"
   done
 done
 
@@ -4,6 +4,13 @@
 # Builds ALL combinations of backends for Linux:
 # - xnnpack
 # - xnnpack-vulkan (requires Vulkan SDK with glslc)
+# - xnnpack-optimized (optimized + quantized CPU kernels)
+# - xnnpack-noexcept (FFI wrapper built with -fno-exceptions, for size and
+#   overhead comparison against xnnpack)
+#
+# On x64, the CPU-only variants are additionally built for the x86-64-v2, v3
+# (AVX2) and v4 (AVX-512) microarchitecture levels (Release only), named
+# linux-x64-v3-xnnpack-... etc.
 #
 # Usage: ./build-linux.sh [VERSION]
 # Example: ./build-linux.sh 1.3.1
@@ -45,12 +52,26 @@ check_vulkan() {
     return 1
 }
 
-# All variants to build: backends:vulkan
+# All variants to build: backends:vulkan:optimized:noexcept
 # Define all variants - if Vulkan variant is listed and SDK is missing, build will fail
+# "optimized" variants link optimized + quantized CPU kernels instead of portable-only
+# "noexcept" variants build the FFI wrapper with -fno-exceptions (ET_NO_EXCEPTIONS)
 VARIANTS=(
-  "xnnpack:OFF"
-  "xnnpack-vulkan:ON"
+  "xnnpack:OFF:OFF:OFF"
+  "xnnpack-vulkan:ON:OFF:OFF"
+  "xnnpack-optimized:OFF:ON:OFF"
+  "xnnpack-noexcept:OFF:OFF:ON"
+)
+
+# x86-64 microarchitecture levels built on top of the baseline (x64 only)
+ISA_LEVELS=()
+ISA_VARIANTS=(
+  "xnnpack:OFF:OFF:OFF"
+  "xnnpack-optimized:OFF:ON:OFF"
 )
+if [ "$ARCH" = "x64" ]; then
+  ISA_LEVELS=("v2" "v3" "v4")
+fi
 
 echo "============================================================"
 echo "ExecuTorch Linux Build Script"
@@ -59,6 +80,7 @@ echo "  Version: ${VERSION}"
 echo "  Platform: ${PLATFORM}"
 echo "  Architecture: ${ARCH}"
 echo "  Variants: ${#VARIANTS[@]}"
+echo "  ISA levels: ${ISA_LEVELS[*]:-(baseline only)}"
 echo "============================================================"
 
 # Install dependencies
@@ -79,13 +101,17 @@ install_dependencies() {
 build_variant() {
   local backends=$1
   local vulkan=$2
-  local build_type=$3
+  local optimized=$3
+  local noexcept=$4
+  local build_type=$5
+  local isa_level=${6:-}
+  local arch_name="${ARCH}${isa_level:+-${isa_level}}"
   local build_type_lower=$(echo "$build_type" | tr '[:upper:]' '[:lower:]')
-  local build_dir="${PROJECT_DIR}/build-${PLATFORM}-${ARCH}-${backends}-${build_type_lower}"
-  local artifact_name="libexecutorch_ffi-${PLATFORM}-${ARCH}-${backends}-${build_type_lower}.tar.gz"
+  local build_dir="${PROJECT_DIR}/build-${PLATFORM}-${arch_name}-${backends}-${build_type_lower}"
+  local artifact_name="libexecutorch_ffi-${PLATFORM}-${arch_name}-${backends}-${build_type_lower}.tar.gz"
 
   echo ""
-  echo "=== Building ${PLATFORM}-${ARCH}-${backends}-${build_type_lower} ==="
+  echo "=== Building ${PLATFORM}-${arch_name}-${backends}-${build_type_lower} ==="
   echo "  Build directory: ${build_dir}"
 
   # Check Vulkan requirement
@@ -109,6 +135,9 @@ build_variant() {
     -DET_BUILD_COREML=OFF \
     -DET_BUILD_MPS=OFF \
     -DET_BUILD_QNN=OFF \
+    -DET_BUILD_OPTIMIZED_KERNELS="${optimized}" \
+    -DET_NO_EXCEPTIONS="${noexcept}" \
+    -DET_X86_64_LEVEL="${isa_level}" \
     -DCMAKE_INSTALL_PREFIX="${build_dir}/install"
 
   # Build
@@ -137,9 +166,16 @@ mkdir -p dist
 
 # Build all variants
 for variant in "${VARIANTS[@]}"; do
-  IFS=':' read -r backends vulkan <<< "$variant"
-  build_variant "$backends" "$vulkan" "Release"
-  build_variant "$backends" "$vulkan" "Debug"
+  IFS=':' read -r backends vulkan optimized noexcept <<< "$variant"
+  build_variant "$backends" "$vulkan" "$optimized" "$noexcept" "Release"
+  build_variant "$backends" "$vulkan" "$optimized" "$noexcept" "Debug"
+done
+
+for isa_level in "${ISA_LEVELS[@]}"; do
+  for variant in "${ISA_VARIANTS[@]}"; do
+    IFS=':' read -r backends vulkan optimized noexcept <<< "$variant"
+    build_variant "$backends" "$vulkan" "$optimized" "$noexcept" "Release" "$isa_level"
+  done
 done
 
 echo ""
@@ -0,0 +1,144 @@
+#!/bin/bash
+# build-pgo.sh - Build an LTO + profile-guided-optimized executorch_ffi
+#
+# Two-stage build for the host platform (Linux / macOS):
+#   1. Instrumented build (ET_PGO=GENERATE, LTO on)
+#   2. Training run: a workload that loads the instrumented library and runs
+#      representative models (e.g. your app's benchmark / integration tests)
+#   3. Profile merge (Clang only)
+#   4. Optimized rebuild of the SAME build directory (ET_PGO=USE)
+#
+# The training workload decides what gets optimized: run the models, backends
+# and input shapes you ship. Profiles from an unrepresentative workload can
+# make cold paths faster at the expense of hot ones.
+#
+# Usage: ./build-pgo.sh --train "<command>" [options] [-- <extra cmake args>]
+# Example:
+#   ./build-pgo.sh --train "flutter test integration_test/benchmark_test.dart" \
+#     -- -DET_BUILD_OPTIMIZED_KERNELS=ON
+
+set -e
+
+VERSION="1.3.1"
+TRAIN_CMD=""
+BUILD_TYPE="Release"
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(dirname "$SCRIPT_DIR")"
+CACHE_DIR="${PROJECT_DIR}/.cache"
+BUILD_DIR="${PROJECT_DIR}/build-pgo"
+EXTRA_CMAKE_ARGS=()
+
+print_usage() {
+    echo "Usage: $0 --train \"<command>\" [options] [-- <extra cmake args>]"
+    echo ""
+    echo "Required:"
+    echo "  --train <command>    Training workload run against the instrumented library"
+    echo ""
+    echo "Options:"
+    echo "  --version <ver>      ExecuTorch version (default: ${VERSION})"
+    echo "  --build-dir <path>   Build directory (default: build-pgo)"
+    echo "  --help               Show this help"
+}
+
+while [[ $# -gt 0 ]]; do
+    case $1 in
+        --train)
+            TRAIN_CMD="$2"
+            shift 2
+            ;;
+        --version)
+            VERSION="$2"
+            shift 2
+            ;;
+        --build-dir)
+            BUILD_DIR="$2"
+            shift 2
+            ;;
+        --help)
+            print_usage
+            exit 0
+            ;;
+        --)
+            shift
+            EXTRA_CMAKE_ARGS=("$@")
+            break
+            ;;
+        *)
+            echo "ERROR: Unknown option: $1"
+            print_usage
+            exit 1
+            ;;
+    esac
+done
+
+if [ -z "$TRAIN_CMD" ]; then
+    echo "ERROR: --train is required"
+    echo ""
+    print_usage
+    exit 1
+fi
+
+PROFILE_DIR="${BUILD_DIR}/pgo-profiles"
+
+if command -v nproc &> /dev/null; then
+    JOBS=$(nproc)
+else
+    JOBS=$(sysctl -n hw.ncpu 2>/dev/null || echo 4)
+fi
+
+echo "============================================================"
+echo "ExecuTorch LTO + PGO Build"
+echo "============================================================"
+echo "  Version:   ${VERSION}"
+echo "  Build dir: ${BUILD_DIR}"
+echo "  Profiles:  ${PROFILE_DIR}"
+echo "  Training:  ${TRAIN_CMD}"
+echo "============================================================"
+
+configure() {
+    local pgo_mode=$1
+    cmake -B "$BUILD_DIR" -S "$PROJECT_DIR" -G Ninja \
+        -DCMAKE_BUILD_TYPE="${BUILD_TYPE}" \
+        -DEXECUTORCH_VERSION="${VERSION}" \
+        -DEXECUTORCH_BUILD_MODE=source \
+        -DEXECUTORCH_CACHE_DIR="${CACHE_DIR}" \
+        -DET_ENABLE_LTO=ON \
+        -DET_PGO="${pgo_mode}" \
+        -DET_PGO_PROFILE_DIR="${PROFILE_DIR}" \
+        -DET_PGO_TRAINING_COMMAND="${TRAIN_CMD}" \
+        -DCMAKE_INSTALL_PREFIX="${BUILD_DIR}/install" \
+        "${EXTRA_CMAKE_ARGS[@]}"
+}
+
+# Stage 1: instrumented build
+echo ""
+echo "=== Stage 1: instrumented build ==="
+rm -rf "$PROFILE_DIR"
+configure GENERATE
+cmake --build "$BUILD_DIR" --parallel "$JOBS"
+
+# Training run
+echo ""
+echo "=== Training run ==="
+cmake --build "$BUILD_DIR" --target pgo-train
+
+# Merge (target only exists for Clang; GCC reads .gcda files directly)
+if grep -q "build pgo-merge" "${BUILD_DIR}/build.ninja"; then
+    echo ""
+    echo "=== Merging profiles ==="
+    cmake --build "$BUILD_DIR" --target pgo-merge
+fi
+
+# Stage 2: optimized rebuild in the same directory
+echo ""
+echo "=== Stage 2: profile-optimized build ==="
+configure USE
+cmake --build "$BUILD_DIR" --parallel "$JOBS"
+cmake --install "$BUILD_DIR"
+
+echo ""
+echo "============================================================"
+echo "PGO Build Complete!"
+echo "============================================================"
+echo "Installed to: ${BUILD_DIR}/install"
+echo "============================================================"
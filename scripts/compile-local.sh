@@ -63,7 +63,8 @@ print_usage() {
     echo "                         macos: arm64, x64"
     echo "                         linux: arm64, x64"
     echo "                       Default: auto-detect"
-    echo "  --backends <list>    Comma-separated: xnnpack,vulkan,coreml,mps"
+    echo "  --backends <list>    Comma-separated: xnnpack,vulkan,coreml,mps,optimized"
+    echo "                       (optimized = optimized + quantized CPU kernels)"
     echo "                       Default: xnnpack"
     echo "  --build-type <type>  Release or Debug (default: Release)"
     echo "  --ndk <path>         Android NDK path (or set ANDROID_NDK_HOME)"
@@ -185,6 +186,7 @@ ET_VULKAN="OFF"
 ET_COREML="OFF"
 ET_MPS="OFF"
 ET_METAL="OFF"
+ET_OPTIMIZED="OFF"
 
 IFS=',' read -ra BACKEND_LIST <<< "$BACKENDS"
 for backend in "${BACKEND_LIST[@]}"; do
@@ -194,6 +196,7 @@ for backend in "${BACKEND_LIST[@]}"; do
         coreml)  ET_COREML="ON" ;;
         mps)     ET_MPS="ON" ;;
         metal)   ET_METAL="ON" ;;
+        optimized) ET_OPTIMIZED="ON" ;;
         *) echo "WARNING: Unknown backend: $backend" ;;
     esac
 done
@@ -301,6 +304,7 @@ cmake -B "$BUILD_DIR" -S "$PROJECT_DIR" \
     -DET_BUILD_METAL="$ET_METAL" \
     -DET_BUILD_VULKAN="$ET_VULKAN" \
     -DET_BUILD_QNN=OFF \
+    -DET_BUILD_OPTIMIZED_KERNELS="$ET_OPTIMIZED" \
     -DCMAKE_INSTALL_PREFIX="$OUTPUT_DIR"
 
 # Build
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""
+pte-oplist.py - List the operators used by ExecuTorch .pte programs
+
+Prints the union of the non-delegated operators ("aten::add.out", ...) that
+the given programs call, sorted and de-duplicated. Operators that live inside
+delegate payloads (XNNPACK, CoreML, Vulkan, ...) are not listed because the
+CPU kernel library never runs them.
+
+Used by the CMake selective build (ET_SELECTIVE_BUILD_MODELS) to decide which
+kernels to register. Has no dependencies beyond the Python standard library:
+the .pte flatbuffer is walked directly instead of importing executorch.
+
+Usage:
+    python3 pte-oplist.py model_a.pte model_b.pte
+    python3 pte-oplist.py --format csv model.pte
+"""
+
+import argparse
+import struct
+import sys
+
+# Field indices from ExecuTorch schema/program.fbs
+PROGRAM_EXECUTION_PLAN = 1
+PLAN_NAME = 0
+PLAN_OPERATORS = 6
+OPERATOR_NAME = 0
+OPERATOR_OVERLOAD = 1
+
+
+class FlatbufferReader:
+    """Minimal read-only flatbuffer table walker."""
+
+    def __init__(self, data):
+        self.data = data
+
+    def u16(self, pos):
+        return struct.unpack_from("<H", self.data, pos)[0]
+
+    def u32(self, pos):
+        return struct.unpack_from("<I", self.data, pos)[0]
+
+    def i32(self, pos):
+        return struct.unpack_from("<i", self.data, pos)[0]
+
+    def root(self):
+        return self.u32(0)
+
+    def field_pos(self, table, field):
+        vtable = table - self.i32(table)
+        vtable_size = self.u16(vtable)
+        entry = 4 + 2 * field
+        if entry >= vtable_size:
+            return None
+        offset = self.u16(vtable + entry)
+        return table + offset if offset else None
+
+    def deref(self, pos):
+        return pos + self.u32(pos)
+
+    def string(self, table, field):
+        pos = self.field_pos(table, field)
+        if pos is None:
+            return ""
+        start = self.deref(pos)
+        length = self.u32(start)
+        return self.data[start + 4:start + 4 + length].decode("utf-8")
+
+    def tables(self, table, field):
+        pos = self.field_pos(table, field)
+        if pos is None:
+            return []
+        vec = self.deref(pos)
+        count = self.u32(vec)
+        return [self.deref(vec + 4 + 4 * i) for i in range(count)]
+
+
+def read_operators(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) < 8 or data[4:6] != b"ET":
+        raise ValueError(f"{path}: not an ExecuTorch program (missing ET file identifier)")
+
+    fb = FlatbufferReader(data)
+    program = fb.root()
+    ops = set()
+    for plan in fb.tables(program, PROGRAM_EXECUTION_PLAN):
+        for op in fb.tables(plan, PLAN_OPERATORS):
+            name = fb.string(op, OPERATOR_NAME)
+            overload = fb.string(op, OPERATOR_OVERLOAD)
+            ops.add(f"{name}.{overload}" if overload else name)
+    return ops
+
+
+def main():
+    parser = argparse.ArgumentParser(description="List operators used by .pte programs")
+    parser.add_argument("models", nargs="+", help=".pte files")
+    parser.add_argument("--format", choices=["lines", "csv"], default="lines",
+                        help="lines (default) or a single comma-separated line")
+    args = parser.parse_args()
+
+    ops = set()
+    for model in args.models:
+        try:
+            ops |= read_operators(model)
+        except (OSError, ValueError, struct.error) as e:
+            print(f"ERROR: {e}", file=sys.stderr)
+            return 1
+
+    ops = sorted(ops)
+    if args.format == "csv":
+        print(",".join(ops))
+    else:
+        print("\n".join(ops))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -14,6 +14,23 @@
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <chrono>
+#include <string>
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <map>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#else
+    #include <cpuid.h>
+#endif
+#endif
 
 // ExecuTorch headers
 #include <executorch/extension/module/module.h>
@@ -23,6 +40,17 @@
 #include <executorch/runtime/core/exec_aten/exec_aten.h>
 #include <executorch/runtime/core/error.h>
 #include <executorch/runtime/core/result.h>
+#include <executorch/runtime/core/hierarchical_allocator.h>
+#include <executorch/runtime/kernel/operator_registry.h>
+#include <executorch/runtime/backend/interface.h>
+
+#ifndef ET_HAS_THREADPOOL
+    #define ET_HAS_THREADPOOL 0
+#endif
+
+#if ET_HAS_THREADPOOL
+#include <executorch/extension/threadpool/threadpool.h>
+#endif
 
 using namespace executorch::extension;
 using namespace executorch::runtime;
@@ -43,21 +71,433 @@ static bool g_debug_enabled = false;  // Simple on/off debug logging
 #define ET_LOG(fmt, ...) \
     do { if (g_debug_enabled) fprintf(stderr, "[ExecuTorch] " fmt "\n", ##__VA_ARGS__); } while(0)
 
+/* ============================================================================
+ * Exception Handling
+ * ============================================================================ */
+
+// ExecuTorch reports failures as Error codes; exceptions can only come from
+// the standard library (allocation) and from backend delegates. Entry points
+// guard those with ET_TRY / ET_CATCH / ET_CATCH_ALL, which compile to plain
+// try/catch normally and away entirely under -fno-exceptions (ET_NO_EXCEPTIONS
+// build option), where an allocation failure terminates instead:
+//
+//   ET_TRY {
+//       ...
+//   } ET_CATCH(const std::exception&, e) {
+//       return create_status(ET_INTERNAL, e.what(), __func__);
+//   } ET_CATCH_ALL {
+//       return create_status(ET_INTERNAL, "unknown error", __func__);
+//   }
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+    #define ET_HAS_EXCEPTIONS 1
+#else
+    #define ET_HAS_EXCEPTIONS 0
+#endif
+
+#if ET_HAS_EXCEPTIONS
+    #define ET_TRY try
+    #define ET_CATCH(type, name) catch (type name)
+    #define ET_CATCH_ALL catch (...)
+#else
+    #include <type_traits>
+
+// Stand-in the never-executed handlers bind their exception variable to
+template <typename E>
+static const E& et_no_exception() {
+    static const E instance{};
+    return instance;
+}
+
+    #define ET_TRY if (true)
+    #define ET_CATCH(type, name) \
+        else if (false) for ([[maybe_unused]] type name = et_no_exception<std::decay_t<type>>(); false;)
+    #define ET_CATCH_ALL else if (false)
+#endif
+
+/* ============================================================================
+ * Memory Placement
+ * ============================================================================ */
+
+#if defined(__linux__)
+    #include <sched.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#elif !defined(_WIN32)
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+#if !defined(_WIN32)
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+#endif
+
+#if defined(__APPLE__)
+    #include <sys/sysctl.h>
+#endif
+
+#if defined(__linux__) && defined(SYS_mbind)
+    #define ET_HAS_NUMA 1
+#else
+    #define ET_HAS_NUMA 0
+#endif
+
+#if ET_HAS_NUMA
+// Parses a sysfs CPU / node list such as "0-15,32-47"
+static std::vector<int> parse_id_list(const char* text) {
+    std::vector<int> ids;
+    const char* p = text;
+    while (*p) {
+        char* end = nullptr;
+        long first = strtol(p, &end, 10);
+        if (end == p) break;
+        long last = first;
+        if (*end == '-') {
+            p = end + 1;
+            last = strtol(p, &end, 10);
+            if (end == p) break;
+        }
+        for (long id = first; id <= last; id++) ids.push_back(static_cast<int>(id));
+        p = end;
+        if (*p == ',') p++;
+        else break;
+    }
+    return ids;
+}
+
+static std::vector<int> read_id_list(const char* path) {
+    char text[4096] = {0};
+    FILE* file = fopen(path, "r");
+    if (!file) return {};
+    size_t read = fread(text, 1, sizeof(text) - 1, file);
+    fclose(file);
+    text[read] = '\0';
+    return parse_id_list(text);
+}
+
+static int32_t numa_node_count() {
+    std::vector<int> nodes = read_id_list("/sys/devices/system/node/online");
+    return nodes.empty() ? 0 : nodes.back() + 1;
+}
+
+static bool numa_node_cpus(int32_t node, cpu_set_t* out) {
+    char path[128];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+    std::vector<int> cpus = read_id_list(path);
+    if (cpus.empty()) return false;
+    CPU_ZERO(out);
+    for (int cpu : cpus) {
+        if (cpu < CPU_SETSIZE) CPU_SET(cpu, out);
+    }
+    return true;
+}
+
+// Prefer `node` for the pages of [addr, addr + size). MPOL_PREFERRED falls
+// back to other nodes instead of failing when the node runs out of memory.
+static bool bind_to_numa_node(void* addr, size_t size, int32_t node) {
+    constexpr int kMpolPreferred = 1;
+    unsigned long mask[16] = {0};
+    constexpr int32_t kMaxNodes = static_cast<int32_t>(sizeof(mask) * 8);
+    if (node < 0 || node >= kMaxNodes - 1) return false;
+    mask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+    return syscall(SYS_mbind, addr, size, kMpolPreferred, mask, kMaxNodes, 0) == 0;
+}
+#endif
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    #define ET_HAS_HUGE_PAGES 1
+#else
+    #define ET_HAS_HUGE_PAGES 0
+#endif
+
+#if ET_HAS_HUGE_PAGES
+// Default huge page size (Hugepagesize in /proc/meminfo), 2 MiB if unknown.
+// This is also the transparent huge page size on x86-64 and arm64 (4K base).
+static size_t huge_page_size() {
+    static const size_t size = [] {
+        size_t kb = 0;
+        FILE* file = fopen("/proc/meminfo", "r");
+        if (file) {
+            char line[256];
+            while (fgets(line, sizeof(line), file)) {
+                if (sscanf(line, "Hugepagesize: %zu kB", &kb) == 1) break;
+            }
+            fclose(file);
+        }
+        return kb > 0 ? kb * 1024 : static_cast<size_t>(2) << 20;
+    }();
+    return size;
+}
+
+// Transparent huge page size (PMD size). The hugetlbfs default above can be
+// 1 GB, far coarser than what THP maps.
+static size_t thp_page_size() {
+    static const size_t size = [] {
+        size_t bytes = 0;
+        FILE* file = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+        if (file) {
+            if (fscanf(file, "%zu", &bytes) != 1) bytes = 0;
+            fclose(file);
+        }
+        return bytes > 0 ? bytes : static_cast<size_t>(2) << 20;
+    }();
+    return size;
+}
+
+// Anonymous mapping of `size` bytes whose start is aligned to `alignment`,
+// so transparent huge pages can back it from the first byte
+static void* map_aligned(size_t size, size_t alignment) {
+    size_t padded = size + alignment;
+    void* raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return MAP_FAILED;
+    uintptr_t begin = reinterpret_cast<uintptr_t>(raw);
+    uintptr_t aligned = (begin + alignment - 1) / alignment * alignment;
+    if (aligned > begin) munmap(raw, aligned - begin);
+    size_t tail = begin + padded - (aligned + size);
+    if (tail > 0) munmap(reinterpret_cast<void*>(aligned + size), tail);
+    return reinterpret_cast<void*>(aligned);
+}
+#endif
+
+/**
+ * Page-aligned buffer for model data and planned memory, optionally bound
+ * to a NUMA node and backed by huge pages. Pages are placed when first
+ * touched, so callers fill the buffer after allocate().
+ */
+class PlacedBuffer {
+public:
+    PlacedBuffer() = default;
+    ~PlacedBuffer() { reset(); }
+
+    PlacedBuffer(const PlacedBuffer&) = delete;
+    PlacedBuffer& operator=(const PlacedBuffer&) = delete;
+
+    PlacedBuffer(PlacedBuffer&& other) noexcept { *this = std::move(other); }
+    PlacedBuffer& operator=(PlacedBuffer&& other) noexcept {
+        if (this != &other) {
+            reset();
+            data_ = other.data_;
+            size_ = other.size_;
+            mapped_size_ = other.mapped_size_;
+            hugetlb_ = other.hugetlb_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.mapped_size_ = 0;
+            other.hugetlb_ = false;
+        }
+        return *this;
+    }
+
+    // numa_node < 0: no placement. ET_HUGE_PAGES_EXPLICIT falls back to
+    // transparent huge pages when the hugetlbfs pool is empty. Returns false
+    // on allocation failure.
+    bool allocate(size_t size, int32_t numa_node, ETHugePages huge_pages = ET_HUGE_PAGES_OFF) {
+        reset();
+        if (size == 0) return true;
+#if defined(_WIN32)
+        (void)numa_node;
+        (void)huge_pages;
+        data_ = static_cast<uint8_t*>(malloc(size));
+        if (!data_) return false;
+#else
+        void* mapped = MAP_FAILED;
+        size_t mapped_size = 0;
+    #if ET_HAS_HUGE_PAGES
+        if (huge_pages != ET_HUGE_PAGES_OFF) {
+        #if defined(MAP_HUGETLB)
+            if (huge_pages == ET_HUGE_PAGES_EXPLICIT) {
+                size_t huge_page = huge_page_size();
+                mapped_size = (size + huge_page - 1) / huge_page * huge_page;
+                mapped = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                hugetlb_ = mapped != MAP_FAILED;
+                if (!hugetlb_) ET_LOG("PlacedBuffer: no hugetlbfs pages available, using transparent huge pages");
+            }
+        #endif
+            if (mapped == MAP_FAILED) {
+                size_t huge_page = thp_page_size();
+                mapped_size = (size + huge_page - 1) / huge_page * huge_page;
+                mapped = map_aligned(mapped_size, huge_page);
+                if (mapped == MAP_FAILED) {
+                    ET_LOG("PlacedBuffer: aligned mapping failed, using base pages");
+                } else if (madvise(mapped, mapped_size, MADV_HUGEPAGE) != 0) {
+                    ET_LOG("PlacedBuffer: madvise(MADV_HUGEPAGE) failed, transparent huge pages disabled?");
+                }
+            }
+        }
+    #else
+        (void)huge_pages;
+    #endif
+        // Huge pages are advisory: without them the buffer uses base pages
+        if (mapped == MAP_FAILED) {
+            size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            mapped_size = (size + page - 1) / page * page;
+            mapped = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        }
+        if (mapped == MAP_FAILED) return false;
+        data_ = static_cast<uint8_t*>(mapped);
+        mapped_size_ = mapped_size;
+    #if ET_HAS_NUMA
+        if (numa_node >= 0 && !bind_to_numa_node(mapped, mapped_size, numa_node)) {
+            ET_LOG("PlacedBuffer: mbind to node %d failed, using default placement", numa_node);
+        }
+    #else
+        (void)numa_node;
+    #endif
+#endif
+        size_ = size;
+        return true;
+    }
+
+    void reset() {
+        if (data_) {
+#if defined(_WIN32)
+            free(data_);
+#else
+            munmap(data_, mapped_size_);
+#endif
+        }
+        data_ = nullptr;
+        size_ = 0;
+        mapped_size_ = 0;
+        hugetlb_ = false;
+    }
+
+    uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    size_t mapped_size() const { return mapped_size_; }
+    bool hugetlb() const { return hugetlb_; }
+
+private:
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    size_t mapped_size_ = 0;
+    bool hugetlb_ = false;  // Backed by hugetlbfs pages (MAP_HUGETLB)
+};
+
+/**
+ * Bytes of the given buffers that are backed by huge pages: hugetlbfs
+ * buffers count in full, for the rest the AnonHugePages of the overlapping
+ * /proc/self/smaps mappings are attributed by overlap. Adjacent mappings
+ * with identical flags are merged by the kernel, so this is an estimate
+ * when a buffer shares its mapping with other memory.
+ */
+static size_t huge_page_backed_bytes(const std::vector<const PlacedBuffer*>& buffers) {
+    size_t backed = 0;
+#if ET_HAS_HUGE_PAGES
+    std::vector<const PlacedBuffer*> transparent;
+    for (const PlacedBuffer* buffer : buffers) {
+        if (buffer->hugetlb()) backed += buffer->size();
+        else if (buffer->data()) transparent.push_back(buffer);
+    }
+    if (transparent.empty()) return backed;
+
+    FILE* file = fopen("/proc/self/smaps", "r");
+    if (!file) return backed;
+    char line[512];
+    uintptr_t start = 0;
+    uintptr_t end = 0;
+    while (fgets(line, sizeof(line), file)) {
+        unsigned long long range_start = 0;
+        unsigned long long range_end = 0;
+        size_t kb = 0;
+        if (sscanf(line, "%llx-%llx ", &range_start, &range_end) == 2) {
+            start = static_cast<uintptr_t>(range_start);
+            end = static_cast<uintptr_t>(range_end);
+        } else if (sscanf(line, "AnonHugePages: %zu kB", &kb) == 1 && kb > 0 && end > start) {
+            for (const PlacedBuffer* buffer : transparent) {
+                uintptr_t begin = reinterpret_cast<uintptr_t>(buffer->data());
+                uintptr_t overlap_start = std::max(start, begin);
+                uintptr_t overlap_end = std::min(end, begin + buffer->size());
+                if (overlap_end <= overlap_start) continue;
+                double share = static_cast<double>(overlap_end - overlap_start) / static_cast<double>(end - start);
+                backed += static_cast<size_t>(share * static_cast<double>(kb) * 1024.0);
+            }
+        }
+    }
+    fclose(file);
+#else
+    (void)buffers;
+#endif
+    return backed;
+}
+
+/**
+ * Pins the calling thread to a NUMA node's CPUs for its lifetime and
+ * restores the previous affinity afterwards. No-op for node < 0.
+ */
+class ScopedNodeAffinity {
+public:
+    explicit ScopedNodeAffinity(int32_t node) {
+#if ET_HAS_NUMA
+        if (node < 0) return;
+        cpu_set_t node_cpus;
+        if (!numa_node_cpus(node, &node_cpus)) return;
+        if (sched_getaffinity(0, sizeof(saved_), &saved_) != 0) return;
+        active_ = sched_setaffinity(0, sizeof(node_cpus), &node_cpus) == 0;
+#else
+        (void)node;
+#endif
+    }
+
+    ~ScopedNodeAffinity() {
+#if ET_HAS_NUMA
+        if (active_) sched_setaffinity(0, sizeof(saved_), &saved_);
+#endif
+    }
+
+    ScopedNodeAffinity(const ScopedNodeAffinity&) = delete;
+    ScopedNodeAffinity& operator=(const ScopedNodeAffinity&) = delete;
+
+private:
+#if ET_HAS_NUMA
+    cpu_set_t saved_;
+    bool active_ = false;
+#endif
+};
+
 /* ============================================================================
  * Internal Structures
  * ============================================================================ */
 
+// Pages of a shared-memory tensor (et_tensor_create_shared / import). Output
+// views of a bound module output share them, so the mapping lives until the
+// last handle is freed.
+struct SharedTensorMemory {
+    int fd = -1;
+    uint8_t* data = nullptr;
+    size_t size = 0;  // Mapped bytes
+    ~SharedTensorMemory();
+};
+
 struct ETTensor {
     ETDType dtype;
     int32_t rank;
     std::vector<int64_t> shape;
     std::vector<uint8_t> data;
+
+    // Set for shared-memory tensors: the data lives in shared->data (the
+    // first shared_size bytes) and `data` stays empty
+    std::shared_ptr<SharedTensorMemory> shared;
+    size_t shared_size = 0;
+
+    uint8_t* bytes() { return shared ? shared->data : data.data(); }
+    const uint8_t* bytes() const { return shared ? shared->data : data.data(); }
+    size_t nbytes() const { return shared ? shared_size : data.size(); }
 };
 
+// Modules whose delegates are bound to the process-wide threadpool; it is
+// only resized while none is (see Thread Count Tuning)
+static std::atomic<int32_t> g_threadpool_module_count{0};
+
 struct ETModule {
     std::unique_ptr<Module> module;
-    std::vector<uint8_t> model_buffer;  // Keep buffer alive for BufferDataLoader
+    PlacedBuffer model_buffer;  // Keep buffer alive for BufferDataLoader
     bool loaded;
+    bool metadata_ready = false;  // input/output_count and specs valid (from the metadata load phase)
     int32_t input_count;
     int32_t output_count;
     std::mutex mutex;  // Thread safety
@@ -66,6 +506,66 @@ struct ETModule {
     // This fixes the bug where local vectors go out of scope but TensorImpl still references them
     std::vector<std::vector<executorch::aten::SizesType>> input_sizes_storage;
     std::vector<std::vector<uint8_t>> input_data_storage;
+
+    int32_t backend = -1;       // ETBackend chosen by et_module_load_preferred
+    double load_time_ms = 0.0;  // Program load + forward init
+    int32_t num_threads = 0;    // Threadpool size its delegates were bound to
+    bool thread_tuned = false;  // num_threads came from its thread autotune
+    bool threadpool_bound = false;  // Counted in g_threadpool_module_count
+
+    // Placed planned memory (NUMA / huge page load options); empty = Module
+    // allocates it
+    int32_t numa_node = -1;
+    ETHugePages huge_pages = ET_HUGE_PAGES_OFF;
+    std::vector<PlacedBuffer> planned_buffers;
+    std::vector<Span<uint8_t>> planned_spans;
+    std::unique_ptr<HierarchicalAllocator> planned_memory;
+
+    // Forward outputs bound to shared-memory tensors (et_module_bind_output),
+    // by output index; the method writes straight into these pages
+    std::vector<std::shared_ptr<SharedTensorMemory>> bound_outputs;
+
+    // Methods other than forward (et_load_options_set_methods). Each has its
+    // own Module sharing `module`'s program, so they initialize concurrently.
+    struct MethodInstance {
+        std::string name;
+        std::unique_ptr<Module> module;
+        double init_time_ms = 0.0;
+    };
+    std::vector<MethodInstance> methods;
+    double forward_init_time_ms = 0.0;
+
+    // Forward instances per shape bucket (et_load_options_set_buckets),
+    // each bound to its own padded input buffers
+    struct BucketInstance {
+        MethodInstance instance;                      // "forward", sharing module's program
+        std::vector<int64_t> sizes;                   // Per bucket axis
+        std::vector<std::vector<int64_t>> shapes;     // Per input; empty = passed through
+        std::vector<std::vector<uint8_t>> buffers;
+        std::vector<std::vector<executorch::aten::SizesType>> tensor_sizes;
+        std::vector<std::unique_ptr<executorch::runtime::etensor::TensorImpl>> tensors;
+        uint64_t hits = 0;
+    };
+    std::vector<ETBucketDim> bucket_inputs;
+    std::vector<ETBucketDim> bucket_outputs;
+    std::vector<BucketInstance> buckets;
+
+    // Extra forward instances that oversized batches are split across
+    // (et_load_options_set_batch_split); `module` runs chunks too
+    int32_t batch_size = 0;            // Rows per chunk; 0 = no splitting
+    int32_t batch_input = 0;           // Input whose dim 0 is the batch
+    std::vector<bool> batch_inputs;    // Per input: split along dim 0
+    std::vector<MethodInstance> batch_instances;
+
+    // The Module (and its methods) reference the buffers above; the method,
+    // bucket and batch instances reference the Module's program and data loader
+    ~ETModule() {
+        batch_instances.clear();
+        buckets.clear();
+        methods.clear();
+        module.reset();
+        if (threadpool_bound) g_threadpool_module_count--;
+    }
 };
 
 /* ============================================================================
@@ -83,8 +583,13 @@ static ETStatus* create_status(ETErrorCode code, const char* message, const char
     return status;
 }
 
+// Success is the common case on hot paths (forward, tensor creation), so it
+// does not allocate: every OK status is this shared, immutable instance and
+// et_status_free() ignores it.
+static ETStatus g_ok_status = {ET_OK, nullptr, nullptr};
+
 static ETStatus* create_ok_status() {
-    return create_status(ET_OK, nullptr, nullptr);
+    return &g_ok_status;
 }
 
 static size_t dtype_size(ETDType dtype) {
@@ -155,11 +660,19 @@ static EValue tensor_to_evalue(const ETTensor* tensor, ETModule* module, int32_t
         ET_LOG("  shape[%d] = %lld", i, static_cast<long long>(tensor->shape[i]));
     }
 
-    // Store data in module (keeps memory alive during forward pass)
-    auto& data = module->input_data_storage[input_index];
-    data = tensor->data;  // Copy data
-
-    ET_LOG("  data_size = %zu bytes", data.size());
+    // Store data in module (keeps memory alive during forward pass).
+    // Shared-memory tensors are used in place: the caller keeps them alive
+    // for the call, and copying would defeat sharing the pages.
+    void* data_ptr;
+    if (tensor->shared) {
+        data_ptr = tensor->shared->data;
+        ET_LOG("  data_size = %zu bytes (shared memory, no copy)", tensor->shared_size);
+    } else {
+        auto& data = module->input_data_storage[input_index];
+        data = tensor->data;  // Copy data
+        data_ptr = data.data();
+        ET_LOG("  data_size = %zu bytes", data.size());
+    }
 
     // Create TensorImpl using module's stored memory
     auto scalar_type = to_scalar_type(tensor->dtype);
@@ -167,7 +680,7 @@ static EValue tensor_to_evalue(const ETTensor* tensor, ETModule* module, int32_t
         scalar_type,
         tensor->rank,
         sizes.data(),
-        data.data()  // Use module's stored data
+        data_ptr
     );
 
     return EValue(executorch::aten::Tensor(impl));
@@ -223,7 +736,7 @@ static ETTensor* evalue_to_tensor(const EValue& evalue, int32_t output_index) {
  * ============================================================================ */
 
 ET_API void et_status_free(ETStatus* status) {
-    if (!status) return;
+    if (!status || status == &g_ok_status) return;
 
     if (status->message) free(status->message);
     if (status->location) free(status->location);
@@ -276,8 +789,9 @@ ET_API ETStatus* et_tensor_create(
     tensor->rank = rank;
     tensor->shape.assign(shape, shape + rank);
 
-    if (data && data_size > 0) {
-        tensor->data.resize(data_size);
+    // NULL data: zero-filled, to be written through et_tensor_mutable_data()
+    tensor->data.resize(data_size);
+    if (data) {
         memcpy(tensor->data.data(), data, data_size);
     }
 
@@ -302,12 +816,24 @@ ET_API const int64_t* et_tensor_shape(const ETTensor* tensor) {
 
 ET_API size_t et_tensor_data_size(const ETTensor* tensor) {
     if (!tensor) return 0;
-    return tensor->data.size();
+    return tensor->nbytes();
 }
 
 ET_API const void* et_tensor_data(const ETTensor* tensor) {
-    if (!tensor || tensor->data.empty()) return nullptr;
-    return tensor->data.data();
+    if (!tensor || tensor->nbytes() == 0) return nullptr;
+    return tensor->bytes();
+}
+
+ET_API void* et_tensor_mutable_data(ETTensor* tensor) {
+    if (!tensor || tensor->nbytes() == 0) return nullptr;
+    return tensor->bytes();
+}
+
+ET_API size_t et_tensor_element_count(const ETTensor* tensor) {
+    if (!tensor) return 0;
+    size_t count = 1;
+    for (int64_t dim : tensor->shape) count *= static_cast<size_t>(dim);
+    return count;
 }
 
 ET_API void et_tensor_free(ETTensor* tensor) {
@@ -316,6 +842,15 @@ ET_API void et_tensor_free(ETTensor* tensor) {
     }
 }
 
+ET_API void et_tensor_finalizer(void* tensor) {
+    et_tensor_free(static_cast<ETTensor*>(tensor));
+}
+
+ET_API void et_tensor_external_finalizer(void* isolate_callback_data, void* tensor) {
+    (void)isolate_callback_data;
+    et_tensor_free(static_cast<ETTensor*>(tensor));
+}
+
 ET_API void et_tensor_array_free(ETTensor** tensors, int32_t count) {
     if (!tensors) return;
 
@@ -325,283 +860,2596 @@ ET_API void et_tensor_array_free(ETTensor** tensors, int32_t count) {
     free(tensors);
 }
 
+ET_API void et_tensor_array_release(ETTensor** tensors) {
+    free(tensors);
+}
+
 /* ============================================================================
- * Module Functions
+ * Shared-Memory Tensors
  * ============================================================================ */
 
-ET_API ETStatus* et_module_load(
-    const uint8_t* data,
-    size_t data_size,
-    ETModule** out
+// Tensor data in an anonymous shared-memory file (memfd on Linux / Android,
+// an immediately unlinked POSIX shm object elsewhere), so another process can
+// map the same pages from the exported fd. Windows has no fd to export.
+
+#if defined(__linux__) && !defined(SYS_memfd_create)
+    #define ET_HAS_SHARED_TENSORS 0  // Kernel headers predate memfd (3.17)
+#elif !defined(_WIN32)
+    #define ET_HAS_SHARED_TENSORS 1
+#else
+    #define ET_HAS_SHARED_TENSORS 0
+#endif
+
+#ifndef MFD_CLOEXEC
+    #define MFD_CLOEXEC 0x0001U
+#endif
+
+SharedTensorMemory::~SharedTensorMemory() {
+#if ET_HAS_SHARED_TENSORS
+    if (data) munmap(data, size);
+    if (fd >= 0) close(fd);
+#endif
+}
+
+// Validates shape / dtype and computes the tensor's byte size
+static ETStatus* shared_tensor_size(
+    const int64_t* shape, int32_t rank, ETDType dtype, size_t* out, const char* location
 ) {
-    ET_LOG("et_module_load: loading model from buffer, size=%zu bytes", data_size);
+    if (!shape || rank <= 0) {
+        return create_status(ET_INVALID_ARGUMENT, "invalid shape or rank", location);
+    }
+    size_t element_count = 1;
+    for (int32_t i = 0; i < rank; i++) {
+        if (shape[i] <= 0) {
+            return create_status(ET_INVALID_ARGUMENT, "shape dimensions must be positive", location);
+        }
+        element_count *= static_cast<size_t>(shape[i]);
+    }
+    if (dtype_size(dtype) == 0) {
+        return create_status(ET_INVALID_ARGUMENT, "invalid dtype", location);
+    }
+    *out = element_count * dtype_size(dtype);
+    return nullptr;
+}
 
-    if (!out) {
-        ET_LOG("et_module_load: ERROR - out pointer is null");
-        return create_status(ET_INVALID_ARGUMENT, "out pointer is null", __func__);
+#if ET_HAS_SHARED_TENSORS
+// Maps `size` bytes of fd (taking ownership of it) into a new tensor
+static ETStatus* map_shared_tensor(
+    int fd, size_t size, const int64_t* shape, int32_t rank, ETDType dtype,
+    ETTensor** out, const char* location
+) {
+    void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        char msg[256];
+        snprintf(msg, sizeof(msg), "mmap of %zu bytes failed: %s", size, strerror(errno));
+        close(fd);
+        return create_status(ET_IO_ERROR, msg, location);
     }
 
-    if (!data || data_size == 0) {
-        ET_LOG("et_module_load: ERROR - invalid model data");
-        return create_status(ET_INVALID_ARGUMENT, "invalid model data", __func__);
+    SharedTensorMemory* mapping = new (std::nothrow) SharedTensorMemory();
+    if (!mapping) {
+        munmap(addr, size);
+        close(fd);
+        return create_status(ET_OUT_OF_MEMORY, "failed to allocate tensor", location);
     }
+    mapping->fd = fd;
+    mapping->data = static_cast<uint8_t*>(addr);
+    mapping->size = size;
+    std::shared_ptr<SharedTensorMemory> memory(mapping);
 
-    // Allocate module
-    ETModule* module = new (std::nothrow) ETModule();
-    if (!module) {
-        ET_LOG("et_module_load: ERROR - failed to allocate module");
-        return create_status(ET_OUT_OF_MEMORY, "failed to allocate module", __func__);
+    ETTensor* tensor = new (std::nothrow) ETTensor();
+    if (!tensor) {
+        return create_status(ET_OUT_OF_MEMORY, "failed to allocate tensor", location);
     }
 
-    try {
-        // Copy model data to keep it alive for BufferDataLoader
-        ET_LOG("et_module_load: copying model data to internal buffer");
-        module->model_buffer.assign(data, data + data_size);
+    tensor->dtype = dtype;
+    tensor->rank = rank;
+    tensor->shape.assign(shape, shape + rank);
+    tensor->shared = std::move(memory);
+    tensor->shared_size = size;
 
-        // Create BufferDataLoader
-        ET_LOG("et_module_load: creating BufferDataLoader");
-        auto data_loader = std::make_unique<BufferDataLoader>(
-            module->model_buffer.data(),
-            module->model_buffer.size()
-        );
+    *out = tensor;
+    return create_ok_status();
+}
+#endif
 
-        // Create Module with the data loader
-        ET_LOG("et_module_load: creating Module");
-        module->module = std::make_unique<Module>(std::move(data_loader));
+// Output `output_index` of a forward pass that ran into bound shared memory:
+// a view onto the same pages instead of a copy. nullptr if the method did not
+// write there (caller falls back to evalue_to_tensor).
+static ETTensor* shared_output_view(
+    const EValue& evalue, const std::shared_ptr<SharedTensorMemory>& memory, int32_t output_index
+) {
+    if (!memory || !evalue.isTensor()) return nullptr;
+    const auto& tensor = evalue.toTensor();
+    if (tensor.const_data_ptr() != memory->data || tensor.nbytes() > memory->size) {
+        ET_LOG("shared_output_view: output %d not in its bound memory, copying", output_index);
+        return nullptr;
+    }
 
-        // Load the program
-        ET_LOG("et_module_load: loading program");
-        auto load_error = module->module->load();
-        if (load_error != Error::Ok) {
-            int error_code = static_cast<int>(load_error);
-            ET_LOG("et_module_load: ERROR - failed to load ExecuTorch program, error code: %d", error_code);
-            delete module;
-            char msg[256];
-            snprintf(msg, sizeof(msg), "failed to load ExecuTorch program (error code: %d)", error_code);
-            return create_status(ET_MODEL_LOAD_FAILED, msg, __func__);
-        }
+    ETTensor* result = new (std::nothrow) ETTensor();
+    if (!result) return nullptr;
 
-        // Load the forward method (this initializes backend delegates like CoreML, MPS)
-        ET_LOG("et_module_load: loading forward method (initializing backend delegates)");
-        ET_LOG("et_module_load: available backends - XNNPACK: %d, CoreML: %d, Metal: %d, Vulkan: %d",
-               ET_BUILD_XNNPACK, ET_BUILD_COREML, ET_BUILD_METAL, ET_BUILD_VULKAN);
-        auto forward_error = module->module->load_forward();
-        if (forward_error != Error::Ok) {
-            int error_code = static_cast<int>(forward_error);
-            ET_LOG("et_module_load: ERROR - failed to load forward method, error code: %d", error_code);
-            ET_LOG("et_module_load: This may indicate a backend delegate initialization failure");
-            ET_LOG("et_module_load: Common causes: CoreML delegate not compiled in, model exported for different backend");
-            delete module;
-            char msg[256];
-            snprintf(msg, sizeof(msg), "failed to load forward method (error code: %d) - check backend compatibility", error_code);
-            return create_status(ET_MODEL_LOAD_FAILED, msg, __func__);
-        }
-
-        // Get method metadata
-        ET_LOG("et_module_load: getting method metadata");
-        auto method_meta_result = module->module->method_meta("forward");
-        if (method_meta_result.ok()) {
-            auto& meta = method_meta_result.get();
-            module->input_count = static_cast<int32_t>(meta.num_inputs());
-            module->output_count = static_cast<int32_t>(meta.num_outputs());
-            ET_LOG("et_module_load: inputs=%d, outputs=%d", module->input_count, module->output_count);
-        } else {
-            ET_LOG("et_module_load: WARNING - could not get method metadata, assuming 1 input/output");
-            module->input_count = 1;
-            module->output_count = 1;
-        }
+    auto sizes = tensor.sizes();
+    result->dtype = from_scalar_type(tensor.scalar_type());
+    result->rank = static_cast<int32_t>(sizes.size());
+    result->shape.assign(sizes.begin(), sizes.end());
+    result->shared = memory;
+    result->shared_size = tensor.nbytes();
+    return result;
+}
 
-        module->loaded = true;
-        *out = module;
-        ET_LOG("et_module_load: SUCCESS - module loaded at %p", static_cast<void*>(module));
-        return create_ok_status();
+ET_API ETStatus* et_tensor_create_shared(
+    const int64_t* shape,
+    int32_t rank,
+    ETDType dtype,
+    ETTensor** out
+) {
+    if (!out) {
+        return create_status(ET_INVALID_ARGUMENT, "out pointer is null", __func__);
+    }
+    *out = nullptr;
 
-    } catch (const std::exception& e) {
-        ET_LOG("et_module_load: ERROR - C++ exception: %s", e.what());
-        delete module;
-        char msg[512];
-        snprintf(msg, sizeof(msg), "backend initialization failed: %s", e.what());
-        return create_status(ET_MODEL_LOAD_FAILED, msg, __func__);
-    } catch (...) {
-        ET_LOG("et_module_load: ERROR - unknown C++ exception");
-        delete module;
-        return create_status(ET_MODEL_LOAD_FAILED, "unknown backend initialization error", __func__);
+    size_t size = 0;
+    if (ETStatus* status = shared_tensor_size(shape, rank, dtype, &size, __func__)) {
+        return status;
+    }
+
+#if ET_HAS_SHARED_TENSORS
+  #if defined(__linux__)
+    int fd = static_cast<int>(syscall(SYS_memfd_create, "et_tensor", MFD_CLOEXEC));
+  #else
+    // No memfd: a uniquely named shm object, unlinked right away so only the
+    // fd refers to it (and nothing leaks if the process dies)
+    static std::atomic<uint32_t> counter{0};
+    char name[64];
+    snprintf(name, sizeof(name), "/et_tensor.%d.%u", static_cast<int>(getpid()), counter++);
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0) {
+        shm_unlink(name);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+  #endif
+    if (fd < 0) {
+        char msg[256];
+        snprintf(msg, sizeof(msg), "failed to create shared memory: %s", strerror(errno));
+        return create_status(errno == ENOSYS ? ET_UNSUPPORTED : ET_IO_ERROR, msg, __func__);
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        char msg[256];
+        snprintf(msg, sizeof(msg), "failed to size shared memory to %zu bytes: %s", size, strerror(errno));
+        close(fd);
+        return create_status(ET_IO_ERROR, msg, __func__);
     }
+
+    ET_LOG("et_tensor_create_shared: fd=%d, %zu bytes", fd, size);
+    return map_shared_tensor(fd, size, shape, rank, dtype, out, __func__);
+#else
+    return create_status(ET_UNSUPPORTED, "shared-memory tensors are not supported on this platform", __func__);
+#endif
 }
 
-ET_API ETStatus* et_module_load_file(
-    const char* path,
-    ETModule** out
+ET_API ETStatus* et_tensor_import_shared(
+    int32_t fd,
+    const int64_t* shape,
+    int32_t rank,
+    ETDType dtype,
+    ETTensor** out
 ) {
-    ET_LOG("et_module_load_file: loading model from file: %s", path ? path : "(null)");
-
     if (!out) {
-        ET_LOG("et_module_load_file: ERROR - out pointer is null");
         return create_status(ET_INVALID_ARGUMENT, "out pointer is null", __func__);
     }
-
-    if (!path) {
-        ET_LOG("et_module_load_file: ERROR - path is null");
-        return create_status(ET_INVALID_ARGUMENT, "path is null", __func__);
+    *out = nullptr;
+    if (fd < 0) {
+        return create_status(ET_INVALID_ARGUMENT, "invalid file descriptor", __func__);
     }
 
-    // Allocate module
-    ETModule* module = new (std::nothrow) ETModule();
-    if (!module) {
-        ET_LOG("et_module_load_file: ERROR - failed to allocate module");
-        return create_status(ET_OUT_OF_MEMORY, "failed to allocate module", __func__);
+    size_t size = 0;
+    if (ETStatus* status = shared_tensor_size(shape, rank, dtype, &size, __func__)) {
+        return status;
     }
 
-    try {
-        // Create Module directly from file path
-        ET_LOG("et_module_load_file: creating Module with MmapUseMlockIgnoreErrors");
-        module->module = std::make_unique<Module>(
-            std::string(path),
-            Module::LoadMode::MmapUseMlockIgnoreErrors
+#if ET_HAS_SHARED_TENSORS
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        char msg[256];
+        snprintf(msg, sizeof(msg), "fstat failed: %s", strerror(errno));
+        return create_status(ET_IO_ERROR, msg, __func__);
+    }
+    if (static_cast<uint64_t>(info.st_size) < size) {
+        char msg[256];
+        snprintf(msg, sizeof(msg), "shared memory too small: %zu bytes needed, %lld available",
+                 size, static_cast<long long>(info.st_size));
+        return create_status(ET_INVALID_ARGUMENT, msg, __func__);
+    }
+
+    // The tensor owns its own descriptor; the caller keeps (and closes) fd
+    int own_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (own_fd < 0) {
+        char msg[256];
+        snprintf(msg, sizeof(msg), "failed to duplicate fd %d: %s", fd, strerror(errno));
+        return create_status(ET_IO_ERROR, msg, __func__);
+    }
+
+    ET_LOG("et_tensor_import_shared: fd=%d (own %d), %zu bytes", fd, own_fd, size);
+    return map_shared_tensor(own_fd, size, shape, rank, dtype, out, __func__);
+#else
+    return create_status(ET_UNSUPPORTED, "shared-memory tensors are not supported on this platform", __func__);
+#endif
+}
+
+ET_API int32_t et_tensor_shared_fd(const ETTensor* tensor) {
+    if (!tensor || !tensor->shared) return -1;
+    return tensor->shared->fd;
+}
+
+/* ============================================================================
+ * Backend Registry Helpers
+ * ============================================================================ */
+
+// Name each backend registers itself under in ExecuTorch's backend registry
+static const char* backend_registry_name(ETBackend backend) {
+    switch (backend) {
+        case ET_BACKEND_XNNPACK: return "XnnpackBackend";
+        case ET_BACKEND_COREML: return "CoreMLBackend";
+        case ET_BACKEND_MPS: return "MPSBackend";
+        case ET_BACKEND_VULKAN: return "VulkanBackend";
+        case ET_BACKEND_QNN: return "QnnBackend";
+        case ET_BACKEND_METAL: return "MetalBackend";
+        default: return nullptr;
+    }
+}
+
+static const char* backend_display_name(ETBackend backend) {
+    switch (backend) {
+        case ET_BACKEND_XNNPACK: return "XNNPACK";
+        case ET_BACKEND_COREML: return "CoreML";
+        case ET_BACKEND_MPS: return "MPS";
+        case ET_BACKEND_VULKAN: return "Vulkan";
+        case ET_BACKEND_QNN: return "QNN";
+        case ET_BACKEND_METAL: return "Metal";
+        case ET_BACKEND_PORTABLE: return "portable";
+        default: return "unknown";
+    }
+}
+
+static constexpr int kBackendCount = ET_BACKEND_PORTABLE + 1;
+
+struct BackendProbeResult {
+    bool registered = false;  // Linked in and registered with the runtime
+    bool available = false;   // is_available(): device / driver usable
+    double init_ms = 0.0;     // Time is_available() took
+};
+
+static BackendProbeResult g_backend_probes[kBackendCount];
+static std::once_flag g_backend_probe_once[kBackendCount];
+
+// Runs the backend's runtime availability check once per process. For GPU /
+// NPU backends this is where the device, driver or ICD gets initialized, so
+// it is the step that fails on devices without working drivers.
+static const BackendProbeResult& probe_backend(ETBackend backend) {
+    int index = static_cast<int>(backend);
+    std::call_once(g_backend_probe_once[index], [backend, index]() {
+        BackendProbeResult& result = g_backend_probes[index];
+        if (backend == ET_BACKEND_PORTABLE) {
+            result.registered = true;
+            result.available = true;
+            return;
+        }
+
+        BackendInterface* backend_class = get_backend_class(backend_registry_name(backend));
+        result.registered = backend_class != nullptr;
+        if (!backend_class) return;
+
+        auto start = std::chrono::steady_clock::now();
+        ET_TRY {
+            result.available = backend_class->is_available();
+        } ET_CATCH_ALL {
+            result.available = false;
+        }
+        result.init_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        ET_LOG("probe: %s registered=1 available=%d init=%.2f ms",
+               backend_display_name(backend), result.available ? 1 : 0, result.init_ms);
+    });
+    return g_backend_probes[index];
+}
+
+static bool is_valid_backend(ETBackend backend) {
+    return backend >= ET_BACKEND_XNNPACK && backend <= ET_BACKEND_PORTABLE;
+}
+
+static bool backend_runtime_available(ETBackend backend) {
+    return is_valid_backend(backend) && probe_backend(backend).available;
+}
+
+/* ============================================================================
+ * Load Options
+ * ============================================================================ */
+
+struct ETLoadOptions {
+    // Per backend: options in the order their keys were first set
+    std::map<ETBackend, std::vector<BackendOption>> backend_options;
+
+    // Thread count calibration (et_load_options_set_thread_autotune)
+    bool tune_threads = false;
+    std::vector<int32_t> thread_candidates;  // Empty = default sweep
+    int32_t tune_iterations = 5;
+    std::string tuning_cache_path;           // Empty = no persistence
+
+    // NUMA placement (et_load_options_set_numa_node); -1 = default placement
+    int32_t numa_node = -1;
+
+    // Huge page backing of model buffer and planned memory
+    ETHugePages huge_pages = ET_HUGE_PAGES_OFF;
+
+    // Methods initialized besides forward (et_load_options_set_methods)
+    std::vector<std::string> methods;
+    bool all_methods = false;    // Every method in the program
+    bool parallel_init = false;  // One thread per method
+
+    // Shape buckets (et_load_options_set_buckets)
+    std::vector<int64_t> bucket_sizes;  // Bucket count x bucket_axes
+    int32_t bucket_axes = 0;
+    std::vector<ETBucketDim> bucket_inputs;
+    std::vector<ETBucketDim> bucket_outputs;
+
+    // Forward instances for oversized batches (et_load_options_set_batch_split);
+    // 0 = no splitting
+    int32_t batch_instances = 0;
+    std::vector<int32_t> batch_split_inputs;  // Inputs to split; empty = dim 0 matching
+
+    // Load phase reporting (et_load_options_set_progress_callback)
+    ETLoadProgressCallback progress_callback = nullptr;
+    void* progress_user_data = nullptr;
+    int64_t progress_port = 0;          // et_load_options_set_progress_port
+    int64_t progress_request_id = 0;    // Set by the *_async_port loads
+
+    // Whether model buffer and planned memory are allocated by this library
+    bool places_memory() const { return numa_node >= 0 || huge_pages != ET_HUGE_PAGES_OFF; }
+};
+
+ET_API ETLoadOptions* et_load_options_create(void) {
+    return new (std::nothrow) ETLoadOptions();
+}
+
+ET_API void et_load_options_free(ETLoadOptions* options) {
+    delete options;
+}
+
+template <typename T>
+static ETStatus* set_backend_option(
+    ETLoadOptions* options,
+    ETBackend backend,
+    const char* key,
+    T value,
+    const char* func
+) {
+    if (!options || !key || !*key) {
+        return create_status(ET_INVALID_ARGUMENT, "Invalid argument: null options or empty key", func);
+    }
+    if (!backend_registry_name(backend)) {
+        return create_status(ET_INVALID_ARGUMENT, "Unknown backend", func);
+    }
+    if (strlen(key) >= kMaxOptionKeyLength) {
+        return create_status(ET_INVALID_ARGUMENT, "Option key too long (max 63 characters)", func);
+    }
+
+    ET_TRY {
+        auto& entries = options->backend_options[backend];
+        BackendOption* option = nullptr;
+        for (auto& entry : entries) {
+            if (strcmp(entry.key, key) == 0) option = &entry;
+        }
+        if (!option) {
+            entries.emplace_back();
+            option = &entries.back();
+            strncpy(option->key, key, kMaxOptionKeyLength - 1);
+        }
+        option->value = value;
+    } ET_CATCH(const std::bad_alloc&, e) {
+        return create_status(ET_OUT_OF_MEMORY, "Failed to store option", func);
+    }
+    return create_ok_status();
+}
+
+ET_API ETStatus* et_load_options_set_backend_int(
+    ETLoadOptions* options,
+    ETBackend backend,
+    const char* key,
+    int32_t value
+) {
+    return set_backend_option(options, backend, key, static_cast<int>(value), __func__);
+}
+
+ET_API ETStatus* et_load_options_set_backend_bool(
+    ETLoadOptions* options,
+    ETBackend backend,
+    const char* key,
+    int32_t value
+) {
+    return set_backend_option(options, backend, key, value != 0, __func__);
+}
+
+ET_API ETStatus* et_load_options_set_backend_string(
+    ETLoadOptions* options,
+    ETBackend backend,
+    const char* key,
+    const char* value
+) {
+    if (!value) {
+        return create_status(ET_INVALID_ARGUMENT, "Invalid argument: value is null", __func__);
+    }
+    if (strlen(value) >= kMaxOptionValueLength) {
+        return create_status(ET_INVALID_ARGUMENT, "Option value too long (max 255 characters)", __func__);
+    }
+    std::array<char, kMaxOptionValueLength> buffer{};
+    strncpy(buffer.data(), value, kMaxOptionValueLength - 1);
+    return set_backend_option(options, backend, key, buffer, __func__);
+}
+
+// Backend options are process-wide in ExecuTorch and read by delegates in
+// init(). Loads that use them hold this lock from set to restore, so a
+// concurrent load never initializes with another model's options.
+static std::mutex g_backend_options_mutex;
+
+ET_API ETStatus* et_load_options_set_thread_autotune(
+    ETLoadOptions* options,
+    const int32_t* candidates,
+    int32_t candidate_count,
+    int32_t iterations,
+    const char* cache_path
+) {
+    if (!options || candidate_count < 0 || (candidate_count > 0 && !candidates) || iterations < 0) {
+        return create_status(ET_INVALID_ARGUMENT, "Invalid argument", __func__);
+    }
+    for (int32_t i = 0; i < candidate_count; i++) {
+        if (candidates[i] <= 0) {
+            return create_status(ET_INVALID_ARGUMENT, "Thread counts must be positive", __func__);
+        }
+    }
+
+    ET_TRY {
+        options->tune_threads = true;
+        options->thread_candidates.assign(candidates, candidates + candidate_count);
+        options->tune_iterations = iterations > 0 ? iterations : 5;
+        options->tuning_cache_path = cache_path ? cache_path : "";
+    } ET_CATCH(const std::bad_alloc&, e) {
+        return create_status(ET_OUT_OF_MEMORY, "Failed to store options", __func__);
+    }
+    return create_ok_status();
+}
+
+ET_API ETStatus* et_load_options_set_numa_node(ETLoadOptions* options, int32_t node) {
+    if (!options || node < -1) {
+        return create_status(ET_INVALID_ARGUMENT, "Invalid argument", __func__);
+    }
+#if ET_HAS_NUMA
+    if (node >= numa_node_count()) {
+        char msg[128];
+        snprintf(msg, sizeof(msg), "NUMA node %d does not exist (%d online)", node, numa_node_count());
+        return create_status(ET_INVALID_ARGUMENT, msg, __func__);
+    }
+#else
+    if (node >= 0) {
+        return create_status(ET_UNSUPPORTED, "NUMA placement is only supported on Linux", __func__);
+    }
+#endif
+    options->numa_node = node;
+    return create_ok_status();
+}
+
+ET_API ETStatus* et_load_options_set_huge_pages(ETLoadOptions* options, ETHugePages mode) {
+    if (!options || (mode != ET_HUGE_PAGES_OFF && mode != ET_HUGE_PAGES_TRANSPARENT &&
+                     mode != ET_HUGE_PAGES_EXPLICIT)) {
+        return create_status(ET_INVALID_ARGUMENT, "Invalid argument", __func__);
+    }
+#if !ET_HAS_HUGE_PAGES
+    if (mode != ET_HUGE_PAGES_OFF) {
+        return create_status(ET_UNSUPPORTED, "Huge pages are only supported on Linux", __func__);
+    }
+#endif
+    options->huge_pages = mode;
+    return create_ok_status();
+}
+
+ET_API ETStatus* et_load_options_set_progress_callback(
+    ETLoadOptions* options,
+    ETLoadProgressCallback callback,
+    void* user_data
+) {
+    if (!options) {
+        return create_status(ET_INVALID_ARGUMENT, "Invalid argument: options is null", __func__);
+    }
+    options->progress_callback = callback;
+    options->progress_user_data = user_data;
+    return create_ok_status();
+}
+
+ET_API ETStatus* et_load_options_set_progress_port(ETLoadOptions* options, int64_t port) {
+    if (!options) {
+        return create_status(ET_INVALID_ARGUMENT, "Invalid argument: options is null", __func__);
+    }
+    options->progress_port = port;
+    return create_ok_status();
+}
+
+ET_API ETStatus* et_load_options_set_methods(
+    ETLoadOptions* options,
+    const char* const* names,
+    int32_t count,
+    int32_t parallel
+) {
+    if (!options || count < 0 || (count > 0 && !names)) {
+        return create_status(ET_INVALID_ARGUMENT, "Invalid argument", __func__);
+    }
+    for (int32_t i = 0; i < count; i++) {
+        if (!names[i] || !*names[i]) {
+            return create_status(ET_INVALID_ARGUMENT, "Method names must be non-empty", __func__);
+        }
+    }
+    ET_TRY {
+        options->methods.assign(names, names + count);
+    } ET_CATCH(const std::bad_alloc&, e) {
+        return create_status(ET_OUT_OF_MEMORY, "Failed to store method names", __func__);
+    }
+    options->all_methods = names == nullptr;
+    options->parallel_init = parallel != 0;
+    return create_ok_status();
+}
+
+// XNNPACK backend option key / values (WorkspaceSharingMode)
+static constexpr const char* kXnnpackWorkspaceSharingKey = "workspace_sharing_mode";
+
+static bool is_valid_workspace_sharing(ETXnnpackWorkspaceSharing mode) {
+    return mode == ET_XNNPACK_WORKSPACE_DISABLED ||
+           mode == ET_XNNPACK_WORKSPACE_PER_MODEL ||
+           mode == ET_XNNPACK_WORKSPACE_GLOBAL;
+}
+
+ET_API ETStatus* et_load_options_set_xnnpack_workspace_sharing(
+    ETLoadOptions* options,
+    ETXnnpackWorkspaceSharing mode
+) {
+    if (!is_valid_workspace_sharing(mode)) {
+        return create_status(ET_INVALID_ARGUMENT, "Invalid workspace sharing mode", __func__);
+    }
+    return set_backend_option(options, ET_BACKEND_XNNPACK, kXnnpackWorkspaceSharingKey,
+                              static_cast<int>(mode), __func__);
+}
+
+ET_API ETStatus* et_xnnpack_set_workspace_sharing(ETXnnpackWorkspaceSharing mode) {
+    if (!is_valid_workspace_sharing(mode)) {
+        return create_status(ET_INVALID_ARGUMENT, "Invalid workspace sharing mode", __func__);
+    }
+    const char* name = backend_registry_name(ET_BACKEND_XNNPACK);
+    if (!get_backend_class(name)) {
+        return create_status(ET_UNSUPPORTED, "XNNPACK backend is not built in", __func__);
+    }
+
+    BackendOption option;
+    strncpy(option.key, kXnnpackWorkspaceSharingKey, kMaxOptionKeyLength - 1);
+    option.value = static_cast<int>(mode);
+
+    // Not while a load has temporarily overridden the option
+    std::lock_guard<std::mutex> lock(g_backend_options_mutex);
+    Error error = set_option(name, Span<BackendOption>(&option, 1));
+    if (error != Error::Ok) {
+        char msg[128];
+        snprintf(msg, sizeof(msg), "XNNPACK rejected workspace sharing mode (error code: %d)", static_cast<int>(error));
+        return create_status(ET_INTERNAL, msg, __func__);
+    }
+    ET_LOG("et_xnnpack_set_workspace_sharing: mode=%d", static_cast<int>(mode));
+    return create_ok_status();
+}
+
+ET_API ETStatus* et_xnnpack_get_workspace_sharing(ETXnnpackWorkspaceSharing* out) {
+    if (!out) {
+        return create_status(ET_INVALID_ARGUMENT, "out pointer is null", __func__);
+    }
+    const char* name = backend_registry_name(ET_BACKEND_XNNPACK);
+    if (!get_backend_class(name)) {
+        return create_status(ET_UNSUPPORTED, "XNNPACK backend is not built in", __func__);
+    }
+
+    BackendOption option;
+    strncpy(option.key, kXnnpackWorkspaceSharingKey, kMaxOptionKeyLength - 1);
+    option.value = 0;
+
+    std::lock_guard<std::mutex> lock(g_backend_options_mutex);
+    Error error = get_option(name, Span<BackendOption>(&option, 1));
+    const int* mode = std::get_if<int>(&option.value);
+    if (error != Error::Ok || !mode) {
+        char msg[128];
+        snprintf(msg, sizeof(msg), "Failed to read XNNPACK workspace sharing mode (error code: %d)", static_cast<int>(error));
+        return create_status(ET_INTERNAL, msg, __func__);
+    }
+    *out = static_cast<ETXnnpackWorkspaceSharing>(*mode);
+    return create_ok_status();
+}
+
+/**
+ * Applies load-time backend options and restores the previous values when it
+ * goes out of scope (after delegate initialization).
+ */
+class ScopedBackendOptions {
+public:
+    ScopedBackendOptions() = default;
+    ScopedBackendOptions(const ScopedBackendOptions&) = delete;
+    ScopedBackendOptions& operator=(const ScopedBackendOptions&) = delete;
+
+    ~ScopedBackendOptions() {
+        for (auto& saved : saved_) {
+            Error error = set_option(saved.first, Span<BackendOption>(saved.second.data(), saved.second.size()));
+            if (error != Error::Ok) {
+                ET_LOG("backend options: failed to restore %s options (error %d)",
+                       saved.first, static_cast<int>(error));
+            }
+        }
+    }
+
+    // Returns nullptr on success, an error status otherwise
+    ETStatus* apply(const ETLoadOptions* options, const char* func) {
+        if (!options || options->backend_options.empty()) return nullptr;
+
+        lock_ = std::unique_lock<std::mutex>(g_backend_options_mutex);
+
+        for (const auto& entry : options->backend_options) {
+            const char* name = backend_registry_name(entry.first);
+            if (!get_backend_class(name)) {
+                char msg[256];
+                snprintf(msg, sizeof(msg), "backend options given for %s, which is not built in", name);
+                return create_status(ET_INVALID_ARGUMENT, msg, func);
+            }
+
+            // Snapshot current values so they can be restored after init
+            std::vector<BackendOption> previous = entry.second;
+            bool can_restore = get_option(name, Span<BackendOption>(previous.data(), previous.size())) == Error::Ok;
+
+            std::vector<BackendOption> values = entry.second;
+            Error error = set_option(name, Span<BackendOption>(values.data(), values.size()));
+            if (error != Error::Ok) {
+                char msg[256];
+                snprintf(msg, sizeof(msg), "%s rejected backend options (error code: %d)", name, static_cast<int>(error));
+                return create_status(ET_INVALID_ARGUMENT, msg, func);
+            }
+            ET_LOG("%s: applied %zu option(s) to %s", func, values.size(), name);
+
+            if (can_restore) {
+                saved_.emplace_back(name, std::move(previous));
+            } else {
+                ET_LOG("%s: WARNING - %s cannot report current option values; options stay set", func, name);
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    std::unique_lock<std::mutex> lock_;
+    std::vector<std::pair<const char*, std::vector<BackendOption>>> saved_;
+};
+
+/* ============================================================================
+ * Thread Count Tuning
+ * ============================================================================ */
+
+// The CPU threadpool is process-wide, and XNNPACK binds each delegate to the
+// pool that exists when the delegate is initialized - resizing replaces the
+// pool. It is therefore only resized while no loaded module can be holding
+// it: delegate initialization takes this lock shared, resizing takes it
+// exclusively and only when g_threadpool_module_count is 0. Loads count
+// themselves under the shared lock before any delegate is initialized.
+static std::shared_mutex g_threadpool_mutex;
+
+static int32_t current_thread_count() {
+#if ET_HAS_THREADPOOL
+    auto* pool = executorch::extension::threadpool::get_threadpool();
+    return pool ? static_cast<int32_t>(pool->get_thread_count()) : 1;
+#else
+    return 1;
+#endif
+}
+
+static constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+static constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+static uint64_t fnv1a_update(uint64_t hash, const uint8_t* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+// FNV-1a of the model file, or of the in-memory model when path is NULL
+static bool hash_model(const ETModule* module, const char* path, uint64_t* out) {
+    uint64_t hash = kFnvOffsetBasis;
+    if (!path) {
+        *out = fnv1a_update(hash, module->model_buffer.data(), module->model_buffer.size());
+        return true;
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    std::vector<uint8_t> chunk(1 << 20);
+    size_t read;
+    while ((read = fread(chunk.data(), 1, chunk.size(), file)) > 0) {
+        hash = fnv1a_update(hash, chunk.data(), read);
+    }
+    bool ok = !ferror(file);
+    fclose(file);
+    *out = hash;
+    return ok;
+}
+
+// CPU model plus logical core count, e.g. "Apple M2 Pro/12"
+static std::string cpu_model_key() {
+    std::string model;
+#if defined(__APPLE__)
+    char brand[256];
+    size_t length = sizeof(brand);
+    if (sysctlbyname("machdep.cpu.brand_string", brand, &length, nullptr, 0) == 0) {
+        model = brand;
+    }
+#elif defined(__linux__)
+    // x86 has "model name"; ARM kernels report "Hardware" or the core parts
+    if (FILE* cpuinfo = fopen("/proc/cpuinfo", "r")) {
+        std::string hardware, parts;
+        char line[512];
+        while (fgets(line, sizeof(line), cpuinfo)) {
+            const char* colon = strchr(line, ':');
+            if (!colon) continue;
+            std::string value(colon + 1);
+            value.erase(0, value.find_first_not_of(" \t"));
+            value.erase(value.find_last_not_of(" \t\r\n") + 1);
+            if (model.empty() && strncmp(line, "model name", 10) == 0) model = value;
+            else if (hardware.empty() && strncmp(line, "Hardware", 8) == 0) hardware = value;
+            else if (strncmp(line, "CPU part", 8) == 0 && parts.find(value) == std::string::npos) {
+                parts += parts.empty() ? value : "," + value;
+            }
+        }
+        fclose(cpuinfo);
+        if (model.empty()) model = !hardware.empty() ? hardware : parts;
+    }
+#elif defined(_WIN32)
+    if (const char* identifier = getenv("PROCESSOR_IDENTIFIER")) model = identifier;
+#endif
+    if (model.empty()) model = "unknown";
+    std::replace(model.begin(), model.end(), '\t', ' ');
+    return model + "/" + std::to_string(std::thread::hardware_concurrency());
+}
+
+// Tuning cache: one "<model hash>\t<cpu key>\t<threads>" line per entry
+static int32_t tuning_cache_lookup(const std::string& path, const std::string& key) {
+    FILE* file = fopen(path.c_str(), "r");
+    if (!file) return 0;
+    int32_t threads = 0;
+    char line[1024];
+    while (fgets(line, sizeof(line), file)) {
+        if (strncmp(line, key.c_str(), key.size()) == 0 && line[key.size()] == '\t') {
+            threads = static_cast<int32_t>(atoi(line + key.size() + 1));
+        }
+    }
+    fclose(file);
+    return threads > 0 ? threads : 0;
+}
+
+static void tuning_cache_store(const std::string& path, const std::string& key, int32_t threads) {
+    std::vector<std::string> lines;
+    if (FILE* file = fopen(path.c_str(), "r")) {
+        char line[1024];
+        while (fgets(line, sizeof(line), file)) {
+            if (strncmp(line, key.c_str(), key.size()) == 0 && line[key.size()] == '\t') continue;
+            lines.emplace_back(line);
+        }
+        fclose(file);
+    }
+    lines.push_back(key + "\t" + std::to_string(threads) + "\n");
+
+    // Write a temporary file and rename, so readers never see a partial file
+    std::string tmp_path = path + ".tmp";
+    FILE* file = fopen(tmp_path.c_str(), "w");
+    if (!file) {
+        ET_LOG("tuning cache: cannot write %s", tmp_path.c_str());
+        return;
+    }
+    for (const auto& line : lines) fputs(line.c_str(), file);
+    bool ok = fclose(file) == 0;
+#if defined(_WIN32)
+    remove(path.c_str());
+#endif
+    if (!ok || rename(tmp_path.c_str(), path.c_str()) != 0) {
+        ET_LOG("tuning cache: failed to update %s", path.c_str());
+        remove(tmp_path.c_str());
+    }
+}
+
+/**
+ * Zero-filled forward inputs shaped from the method metadata.
+ */
+struct SyntheticInputs {
+    std::vector<std::vector<executorch::aten::SizesType>> sizes;
+    std::vector<std::vector<uint8_t>> data;
+    std::vector<std::unique_ptr<executorch::runtime::etensor::TensorImpl>> impls;
+    std::vector<EValue> values;
+};
+
+static bool make_synthetic_inputs(Module& module, SyntheticInputs& out) {
+    auto meta = module.method_meta("forward");
+    if (!meta.ok()) return false;
+
+    size_t count = meta->num_inputs();
+    out.sizes.reserve(count);
+    out.data.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        auto tag = meta->input_tag(i);
+        if (!tag.ok() || *tag != Tag::Tensor) {
+            ET_LOG("thread tuning: input %zu is not a tensor, cannot synthesize", i);
+            return false;
+        }
+        auto info = meta->input_tensor_meta(i);
+        if (!info.ok()) return false;
+
+        auto tensor_sizes = info->sizes();
+        out.sizes.emplace_back(tensor_sizes.begin(), tensor_sizes.end());
+        out.data.emplace_back(info->nbytes(), 0);
+        out.impls.push_back(std::make_unique<executorch::runtime::etensor::TensorImpl>(
+            info->scalar_type(),
+            static_cast<int32_t>(out.sizes.back().size()),
+            out.sizes.back().data(),
+            out.data.back().data()));
+        out.values.emplace_back(executorch::aten::Tensor(out.impls.back().get()));
+    }
+    return true;
+}
+
+// Median forward latency in ms after one warm-up run, < 0 on failure
+static double median_forward_ms(Module& module, const std::vector<EValue>& inputs, int32_t iterations) {
+    if (!module.forward(inputs).ok()) return -1.0;
+
+    std::vector<double> samples;
+    samples.reserve(iterations);
+    for (int32_t i = 0; i < iterations; i++) {
+        auto start = std::chrono::steady_clock::now();
+        if (!module.forward(inputs).ok()) return -1.0;
+        samples.push_back(std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+#if ET_HAS_THREADPOOL
+// Times forward for each candidate on a throw-away Module of the same model,
+// re-initialized per candidate so its delegates bind to the resized pool.
+// Caller holds g_threadpool_mutex exclusively. Returns 0 on failure, with
+// the pool left at the last candidate's size.
+static int32_t sweep_thread_counts(
+    const ETModule* module,
+    const ETLoadOptions& options,
+    const char* path,
+    const std::vector<int32_t>& candidates
+) {
+    auto* pool = executorch::extension::threadpool::get_threadpool();
+    if (!pool) return 0;
+    ScopedBackendOptions backend_options;
+    ETStatus* options_status = backend_options.apply(&options, "thread tuning");
+    if (options_status) {
+        et_status_free(options_status);
+        return 0;
+    }
+
+    int32_t best_threads = 0;
+    double best_ms = 0.0;
+    for (int32_t threads : candidates) {
+        pool->_unsafe_reset_threadpool(static_cast<uint32_t>(threads));
+
+        std::unique_ptr<Module> probe = path
+            ? std::make_unique<Module>(std::string(path), Module::LoadMode::MmapUseMlockIgnoreErrors)
+            : std::make_unique<Module>(std::make_unique<BufferDataLoader>(
+                  module->model_buffer.data(), module->model_buffer.size()));
+        if (probe->load() != Error::Ok || probe->load_forward() != Error::Ok) return 0;
+
+        SyntheticInputs inputs;
+        if (!make_synthetic_inputs(*probe, inputs)) return 0;
+
+        double ms = median_forward_ms(*probe, inputs.values, options.tune_iterations);
+        if (ms < 0) return 0;
+        ET_LOG("thread tuning: %d thread(s) -> %.3f ms", threads, ms);
+
+        if (best_threads == 0 || ms < best_ms) {
+            best_threads = threads;
+            best_ms = ms;
+        }
+        // probe is destroyed here, before the pool is resized again
+    }
+    return best_threads;
+}
+#endif
+
+// Picks the thread count for a module before its delegates are initialized
+// and resizes the threadpool to it. Skipped when other modules are loaded,
+// since resizing would pull the pool out from under their delegates.
+static void tune_thread_count(ETModule* module, const ETLoadOptions& options, const char* path) {
+#if ET_HAS_THREADPOOL
+    std::unique_lock<std::shared_mutex> lock(g_threadpool_mutex);
+    if (g_threadpool_module_count.load() > 0) {
+        ET_LOG("thread tuning: skipped - %d other module(s) share the threadpool",
+               g_threadpool_module_count.load());
+        return;
+    }
+    auto* pool = executorch::extension::threadpool::get_threadpool();
+    if (!pool) {
+        ET_LOG("thread tuning: skipped - no threadpool");
+        return;
+    }
+
+    // A failed sweep leaves the pool at the last candidate's size; put the
+    // original size back so this load and later ones do not inherit it
+    const int32_t original_threads = static_cast<int32_t>(pool->get_thread_count());
+    auto restore = [pool, original_threads]() {
+        if (static_cast<int32_t>(pool->get_thread_count()) != original_threads) {
+            pool->_unsafe_reset_threadpool(static_cast<uint32_t>(original_threads));
+        }
+    };
+
+    std::vector<int32_t> candidates = options.thread_candidates;
+    if (candidates.empty()) {
+        int32_t cores = static_cast<int32_t>(std::max(1u, std::thread::hardware_concurrency()));
+        for (int32_t threads = 1; threads < cores; threads *= 2) candidates.push_back(threads);
+        candidates.push_back(cores);
+    }
+
+    ET_TRY {
+        std::string cache_key;
+        int32_t best = 0;
+        uint64_t model_hash = 0;
+        if (!options.tuning_cache_path.empty() && hash_model(module, path, &model_hash)) {
+            char hash_hex[17];
+            snprintf(hash_hex, sizeof(hash_hex), "%016llx", static_cast<unsigned long long>(model_hash));
+            cache_key = std::string(hash_hex) + "\t" + cpu_model_key();
+            best = tuning_cache_lookup(options.tuning_cache_path, cache_key);
+            if (best > 0) ET_LOG("thread tuning: cache hit, %d thread(s)", best);
+        }
+
+        if (best == 0) {
+            best = candidates.size() == 1 ? candidates[0]
+                                          : sweep_thread_counts(module, options, path, candidates);
+            if (best > 0 && !cache_key.empty()) {
+                tuning_cache_store(options.tuning_cache_path, cache_key, best);
+            }
+        }
+
+        if (best > 0) {
+            pool->_unsafe_reset_threadpool(static_cast<uint32_t>(best));
+            module->thread_tuned = true;
+            ET_LOG("thread tuning: using %d thread(s)", best);
+        } else {
+            restore();
+            ET_LOG("thread tuning: calibration failed, keeping %d thread(s)", original_threads);
+        }
+    } ET_CATCH(const std::exception&, e) {
+        restore();
+        ET_LOG("thread tuning: failed - %s, keeping %d thread(s)", e.what(), original_threads);
+    } ET_CATCH_ALL {
+        restore();
+        ET_LOG("thread tuning: failed with unknown exception, keeping %d thread(s)", original_threads);
+    }
+#else
+    (void)module;
+    (void)options;
+    (void)path;
+    ET_LOG("thread tuning: not available (built without the threadpool extension)");
+#endif
+}
+
+/* ============================================================================
+ * NUMA Placement
+ * ============================================================================ */
+
+ET_API int32_t et_numa_node_count(void) {
+#if ET_HAS_NUMA
+    return numa_node_count();
+#else
+    return 0;
+#endif
+}
+
+ET_API ETStatus* et_numa_pin_threadpool(int32_t node) {
+#if ET_HAS_NUMA && ET_HAS_THREADPOOL
+    if (node < -1 || node >= numa_node_count()) {
+        return create_status(ET_INVALID_ARGUMENT, "Invalid NUMA node", __func__);
+    }
+
+    // Affinity the workers had before the first pin; node -1 restores it
+    static cpu_set_t original_cpus;
+    static bool have_original = false;
+
+    std::shared_lock<std::shared_mutex> threadpool_lock(g_threadpool_mutex);
+    if (!have_original) {
+        if (sched_getaffinity(0, sizeof(original_cpus), &original_cpus) != 0) {
+            return create_status(ET_INTERNAL, "sched_getaffinity failed", __func__);
+        }
+        have_original = true;
+    }
+
+    cpu_set_t target;
+    if (node < 0) {
+        target = original_cpus;
+    } else if (!numa_node_cpus(node, &target)) {
+        return create_status(ET_INTERNAL, "Failed to read the node's CPU list", __func__);
+    }
+
+    auto* pool = executorch::extension::threadpool::get_threadpool();
+    if (!pool) {
+        return create_status(ET_UNSUPPORTED, "No threadpool", __func__);
+    }
+
+    // The pool has no per-worker hook, so run one item per thread and hold
+    // each item until all have started: no worker can then take a second
+    // item, and every worker pins itself exactly once. The calling thread
+    // takes part in run() but keeps its own affinity.
+    const size_t thread_count = pool->get_thread_count();
+    const std::thread::id caller = std::this_thread::get_id();
+    std::atomic<size_t> started{0};
+    std::atomic<int32_t> failures{0};
+    pool->run([&](size_t) {
+        if (std::this_thread::get_id() != caller &&
+            sched_setaffinity(0, sizeof(target), &target) != 0) {
+            failures++;
+        }
+        started++;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+        while (started.load() < thread_count && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+    }, thread_count);
+
+    if (failures.load() > 0 || started.load() < thread_count) {
+        char msg[128];
+        snprintf(msg, sizeof(msg), "Pinned %zu of %zu threadpool thread(s)",
+                 started.load() - static_cast<size_t>(failures.load()), thread_count);
+        return create_status(ET_INTERNAL, msg, __func__);
+    }
+    ET_LOG("et_numa_pin_threadpool: %zu thread(s) pinned to node %d", thread_count, node);
+    return create_ok_status();
+#else
+    (void)node;
+    return create_status(ET_UNSUPPORTED,
+        "Threadpool pinning needs Linux and the threadpool extension", __func__);
+#endif
+}
+
+// Planned (activation) memory of the forward method on the module's NUMA
+// node and/or huge pages. Without this the Module allocates it with malloc,
+// on whichever node the loading thread happened to run.
+static bool place_planned_memory(ETModule* module, const char* func) {
+    auto meta = module->module->method_meta("forward");
+    if (!meta.ok()) return false;
+
+    size_t buffer_count = meta->num_memory_planned_buffers();
+    module->planned_buffers.resize(buffer_count);
+    module->planned_spans.clear();
+    for (size_t i = 0; i < buffer_count; i++) {
+        auto size = meta->memory_planned_buffer_size(i);
+        if (!size.ok() ||
+            !module->planned_buffers[i].allocate(static_cast<size_t>(size.get()), module->numa_node,
+                                                module->huge_pages)) {
+            ET_LOG("%s: failed to allocate planned buffer %zu on node %d", func, i, module->numa_node);
+            return false;
+        }
+        module->planned_spans.emplace_back(module->planned_buffers[i].data(), module->planned_buffers[i].size());
+    }
+    module->planned_memory = std::make_unique<HierarchicalAllocator>(
+        Span<Span<uint8_t>>(module->planned_spans.data(), module->planned_spans.size()));
+    return true;
+}
+
+/* ============================================================================
+ * Shape Buckets
+ * ============================================================================ */
+
+ET_API ETStatus* et_load_options_set_buckets(
+    ETLoadOptions* options,
+    const int64_t* sizes,
+    int32_t bucket_count,
+    int32_t axis_count,
+    const ETBucketDim* inputs,
+    int32_t input_count,
+    const ETBucketDim* outputs,
+    int32_t output_count
+) {
+    if (!options || bucket_count < 0 || input_count < 0 || output_count < 0 ||
+        (bucket_count > 0 && (!sizes || axis_count <= 0)) ||
+        (input_count > 0 && !inputs) || (output_count > 0 && !outputs)) {
+        return create_status(ET_INVALID_ARGUMENT, "Invalid argument", __func__);
+    }
+    if (bucket_count == 0) {
+        options->bucket_sizes.clear();
+        options->bucket_axes = 0;
+        options->bucket_inputs.clear();
+        options->bucket_outputs.clear();
+        return create_ok_status();
+    }
+
+    for (int64_t i = 0; i < static_cast<int64_t>(bucket_count) * axis_count; i++) {
+        if (sizes[i] <= 0) {
+            return create_status(ET_INVALID_ARGUMENT, "Bucket sizes must be positive", __func__);
+        }
+    }
+    std::vector<bool> axis_padded(axis_count, false);
+    for (int32_t i = 0; i < input_count + output_count; i++) {
+        const ETBucketDim& dim = i < input_count ? inputs[i] : outputs[i - input_count];
+        if (dim.index < 0 || dim.dim < 0 || dim.axis < 0 || dim.axis >= axis_count) {
+            return create_status(ET_INVALID_ARGUMENT, "Bucket dim index, dim or axis out of range", __func__);
+        }
+        if (i >= input_count) continue;
+        if (dim.role != ET_BUCKET_PAD && dim.role != ET_BUCKET_MASK) {
+            return create_status(ET_INVALID_ARGUMENT, "Invalid bucket role", __func__);
+        }
+        for (int32_t j = 0; j < i; j++) {
+            if (inputs[j].index == dim.index && inputs[j].role != dim.role) {
+                return create_status(ET_INVALID_ARGUMENT, "All dims of an input must share a role", __func__);
+            }
+        }
+        if (dim.role == ET_BUCKET_PAD) axis_padded[dim.axis] = true;
+    }
+    for (int32_t axis = 0; axis < axis_count; axis++) {
+        if (!axis_padded[axis]) {
+            return create_status(ET_INVALID_ARGUMENT, "Every bucket axis needs an ET_BUCKET_PAD input", __func__);
+        }
+    }
+
+    ET_TRY {
+        options->bucket_sizes.assign(sizes, sizes + static_cast<int64_t>(bucket_count) * axis_count);
+        options->bucket_inputs.assign(inputs, inputs + input_count);
+        options->bucket_outputs.assign(outputs, outputs + output_count);
+    } ET_CATCH(const std::bad_alloc&, e) {
+        return create_status(ET_OUT_OF_MEMORY, "Failed to store buckets", __func__);
+    }
+    options->bucket_axes = axis_count;
+    return create_ok_status();
+}
+
+static size_t element_count(const std::vector<int64_t>& shape) {
+    size_t count = 1;
+    for (int64_t size : shape) count *= static_cast<size_t>(size);
+    return count;
+}
+
+// One element of `dtype` holding `value`
+static std::array<uint8_t, 8> encode_scalar(double value, ETDType dtype) {
+    std::array<uint8_t, 8> bytes{};
+    auto store = [&bytes](auto typed) { memcpy(bytes.data(), &typed, sizeof(typed)); };
+    switch (dtype) {
+        case ET_DTYPE_FLOAT32: store(static_cast<float>(value)); break;
+        case ET_DTYPE_FLOAT64: store(value); break;
+        case ET_DTYPE_INT64: store(static_cast<int64_t>(value)); break;
+        case ET_DTYPE_INT32: store(static_cast<int32_t>(value)); break;
+        case ET_DTYPE_INT16: store(static_cast<int16_t>(value)); break;
+        case ET_DTYPE_INT8: store(static_cast<int8_t>(value)); break;
+        case ET_DTYPE_UINT8: store(static_cast<uint8_t>(value)); break;
+        case ET_DTYPE_BOOL: store(static_cast<uint8_t>(value != 0.0)); break;
+    }
+    return bytes;
+}
+
+static void fill_elements(uint8_t* data, size_t count, const std::array<uint8_t, 8>& value, size_t element_size) {
+    bool zero = std::all_of(value.begin(), value.begin() + element_size, [](uint8_t byte) { return byte == 0; });
+    if (zero) {
+        memset(data, 0, count * element_size);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) memcpy(data + i * element_size, value.data(), element_size);
+}
+
+// Copies the leading block both row-major tensors share (the smaller extent
+// of every dimension): pads when dst is larger, crops when it is smaller
+static void copy_block(
+    const uint8_t* src, const int64_t* src_shape,
+    uint8_t* dst, const int64_t* dst_shape,
+    size_t rank, size_t element_size
+) {
+    if (rank == 0) {
+        memcpy(dst, src, element_size);
+        return;
+    }
+    size_t extent = static_cast<size_t>(std::min(src_shape[0], dst_shape[0]));
+    if (rank == 1) {
+        memcpy(dst, src, extent * element_size);
+        return;
+    }
+    size_t src_stride = element_size;
+    size_t dst_stride = element_size;
+    for (size_t d = 1; d < rank; d++) {
+        src_stride *= static_cast<size_t>(src_shape[d]);
+        dst_stride *= static_cast<size_t>(dst_shape[d]);
+    }
+    for (size_t i = 0; i < extent; i++) {
+        copy_block(src + i * src_stride, src_shape + 1, dst + i * dst_stride, dst_shape + 1, rank - 1, element_size);
+    }
+}
+
+// Sets the leading `extent` block of a row-major tensor to `value`
+static void fill_block(
+    uint8_t* data, const int64_t* shape, const int64_t* extent,
+    size_t rank, const std::array<uint8_t, 8>& value, size_t element_size
+) {
+    if (rank == 0) {
+        memcpy(data, value.data(), element_size);
+        return;
+    }
+    size_t stride = element_size;
+    for (size_t d = 1; d < rank; d++) stride *= static_cast<size_t>(shape[d]);
+    for (int64_t i = 0; i < extent[0]; i++) {
+        fill_block(data + i * stride, shape + 1, extent + 1, rank - 1, value, element_size);
+    }
+}
+
+static const ETBucketDim* bucket_input_role(const ETModule* module, int32_t input) {
+    for (const auto& dim : module->bucket_inputs) {
+        if (dim.index == input) return &dim;
+    }
+    return nullptr;
+}
+
+// Creates a forward instance per bucket with its padded input buffers,
+// sharing module's program. Instances are initialized with the methods.
+static ETStatus* create_bucket_instances(ETModule* module, const ETLoadOptions* options, const char* func) {
+    if (!options || options->bucket_sizes.empty()) return nullptr;
+
+    auto meta = module->module->method_meta("forward");
+    std::shared_ptr<Program> program = module->module->program();
+    if (!meta.ok() || !program) {
+        return create_status(ET_INVALID_STATE, "forward metadata unavailable for buckets", func);
+    }
+
+    // Check the dims against the forward signature
+    auto tensor_rank = [&meta](bool input, int32_t index) -> int64_t {
+        size_t count = input ? meta->num_inputs() : meta->num_outputs();
+        if (index < 0 || static_cast<size_t>(index) >= count) return -1;
+        auto tag = input ? meta->input_tag(index) : meta->output_tag(index);
+        if (!tag.ok() || *tag != Tag::Tensor) return -1;
+        auto info = input ? meta->input_tensor_meta(index) : meta->output_tensor_meta(index);
+        return info.ok() ? static_cast<int64_t>(info->sizes().size()) : -1;
+    };
+    for (bool input : {true, false}) {
+        for (const auto& dim : input ? options->bucket_inputs : options->bucket_outputs) {
+            if (dim.dim >= tensor_rank(input, dim.index)) {
+                char msg[256];
+                snprintf(msg, sizeof(msg), "bucket dim %d of %s %d does not exist in forward",
+                         dim.dim, input ? "input" : "output", dim.index);
+                return create_status(ET_INVALID_ARGUMENT, msg, func);
+            }
+        }
+    }
+
+    size_t axes = static_cast<size_t>(options->bucket_axes);
+    size_t input_count = meta->num_inputs();
+    module->bucket_inputs = options->bucket_inputs;
+    module->bucket_outputs = options->bucket_outputs;
+    module->buckets.resize(options->bucket_sizes.size() / axes);
+    for (size_t b = 0; b < module->buckets.size(); b++) {
+        auto& bucket = module->buckets[b];
+        bucket.sizes.assign(options->bucket_sizes.begin() + b * axes, options->bucket_sizes.begin() + (b + 1) * axes);
+        bucket.shapes.resize(input_count);
+        bucket.buffers.resize(input_count);
+        bucket.tensor_sizes.resize(input_count);
+        bucket.tensors.resize(input_count);
+
+        for (size_t i = 0; i < input_count; i++) {
+            const ETBucketDim* role = bucket_input_role(module, static_cast<int32_t>(i));
+            if (!role) continue;  // Passed through
+            auto info = meta->input_tensor_meta(i);
+            auto upper_bounds = info->sizes();
+            auto& shape = bucket.shapes[i];
+            shape.assign(upper_bounds.begin(), upper_bounds.end());
+            for (const auto& dim : module->bucket_inputs) {
+                if (dim.index != static_cast<int32_t>(i)) continue;
+                int64_t size = bucket.sizes[dim.axis];
+                if (size > upper_bounds[dim.dim]) {
+                    char msg[256];
+                    snprintf(msg, sizeof(msg), "bucket size %lld exceeds the upper bound %lld of input %zu dim %d",
+                             static_cast<long long>(size), static_cast<long long>(upper_bounds[dim.dim]), i, dim.dim);
+                    return create_status(ET_INVALID_ARGUMENT, msg, func);
+                }
+                shape[dim.dim] = size;
+            }
+
+            ETDType dtype = from_scalar_type(info->scalar_type());
+            size_t element_size = dtype_size(dtype);
+            bucket.buffers[i].resize(element_count(shape) * element_size);
+            fill_elements(bucket.buffers[i].data(), element_count(shape),
+                          encode_scalar(role->role == ET_BUCKET_MASK ? 1.0 : role->pad_value, dtype), element_size);
+            bucket.tensor_sizes[i].assign(shape.begin(), shape.end());
+            bucket.tensors[i] = std::make_unique<executorch::runtime::etensor::TensorImpl>(
+                info->scalar_type(), static_cast<ssize_t>(shape.size()),
+                bucket.tensor_sizes[i].data(), bucket.buffers[i].data());
+        }
+
+        bucket.instance.name = "forward";
+        bucket.instance.module = std::make_unique<Module>(program);
+    }
+    ET_LOG("%s: %zu shape buckets over %zu axes", func, module->buckets.size(), axes);
+    return nullptr;
+}
+
+// Runs each bucket once at its shape (padding-filled bucketed inputs,
+// zero-filled pass-through inputs), so the first real call does not pay
+// for delegate reshaping and first-touch page faults. A bucket that fails
+// to run fails the load: its shape is one the export cannot handle.
+static ETStatus* warm_buckets(ETModule* module, const char* func) {
+    auto meta = module->module->method_meta("forward");
+    if (!meta.ok()) {
+        return create_status(ET_MODEL_LOAD_FAILED, "failed to get forward metadata for bucket warm-up", func);
+    }
+
+    std::vector<std::vector<uint8_t>> zero_buffers(meta->num_inputs());
+    std::vector<std::vector<executorch::aten::SizesType>> zero_sizes(meta->num_inputs());
+    std::vector<std::unique_ptr<executorch::runtime::etensor::TensorImpl>> zero_tensors(meta->num_inputs());
+    for (size_t i = 0; i < meta->num_inputs(); i++) {
+        if (bucket_input_role(module, static_cast<int32_t>(i))) continue;
+        auto tag = meta->input_tag(i);
+        auto info = meta->input_tensor_meta(i);
+        if (!tag.ok() || *tag != Tag::Tensor || !info.ok()) {
+            ET_LOG("%s: input %zu is not a tensor, buckets are not warmed up", func, i);
+            return nullptr;
+        }
+        zero_buffers[i].assign(info->nbytes(), 0);
+        zero_sizes[i].assign(info->sizes().begin(), info->sizes().end());
+        zero_tensors[i] = std::make_unique<executorch::runtime::etensor::TensorImpl>(
+            info->scalar_type(), static_cast<ssize_t>(zero_sizes[i].size()),
+            zero_sizes[i].data(), zero_buffers[i].data());
+    }
+
+    for (size_t b = 0; b < module->buckets.size(); b++) {
+        auto& bucket = module->buckets[b];
+        std::vector<EValue> inputs;
+        for (size_t i = 0; i < meta->num_inputs(); i++) {
+            auto* tensor = bucket.tensors[i] ? bucket.tensors[i].get() : zero_tensors[i].get();
+            inputs.emplace_back(executorch::aten::Tensor(tensor));
+        }
+        auto start = std::chrono::steady_clock::now();
+        auto result = bucket.instance.module->execute("forward", inputs);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (!result.ok()) {
+            int error_code = static_cast<int>(result.error());
+            ET_LOG("%s: ERROR - bucket %zu warm-up failed, error code: %d", func, b, error_code);
+            std::string sizes;
+            for (int64_t size : bucket.sizes) sizes += (sizes.empty() ? "" : ",") + std::to_string(size);
+            char msg[512];
+            snprintf(msg, sizeof(msg), "bucket %zu (sizes %s) failed to run forward (error code: %d)",
+                     b, sizes.c_str(), error_code);
+            return create_status(ET_MODEL_LOAD_FAILED, msg, func);
+        }
+        ET_LOG("%s: bucket %zu warmed up in %.2f ms", func, b, ms);
+    }
+    return nullptr;
+}
+
+// Reads the actual axis sizes from the padded inputs and picks the smallest
+// bucket (by elements) that holds them
+static ETStatus* select_bucket(
+    const ETModule* module,
+    ETTensor** inputs,
+    int32_t input_count,
+    std::vector<int64_t>& actual,
+    size_t* out,
+    const char* func
+) {
+    size_t axes = module->buckets.front().sizes.size();
+    actual.assign(axes, -1);
+    for (const auto& dim : module->bucket_inputs) {
+        if (dim.role != ET_BUCKET_PAD) continue;
+        if (dim.index >= input_count || !inputs[dim.index]) {
+            return create_status(ET_INVALID_ARGUMENT, "bucketed input tensor is null", func);
+        }
+        const ETTensor* tensor = inputs[dim.index];
+        if (dim.dim >= tensor->rank) {
+            return create_status(ET_INVALID_ARGUMENT, "bucketed input has too few dimensions", func);
+        }
+        int64_t size = tensor->shape[dim.dim];
+        if (actual[dim.axis] >= 0 && actual[dim.axis] != size) {
+            char msg[128];
+            snprintf(msg, sizeof(msg), "inputs disagree on the size of bucket axis %d", dim.axis);
+            return create_status(ET_INVALID_ARGUMENT, msg, func);
+        }
+        actual[dim.axis] = size;
+    }
+
+    size_t best = module->buckets.size();
+    double best_elements = 0;
+    for (size_t b = 0; b < module->buckets.size(); b++) {
+        const auto& sizes = module->buckets[b].sizes;
+        double elements = 1;
+        bool fits = true;
+        for (size_t a = 0; a < axes; a++) {
+            fits = fits && actual[a] <= sizes[a];
+            elements *= static_cast<double>(sizes[a]);
+        }
+        if (fits && (best == module->buckets.size() || elements < best_elements)) {
+            best = b;
+            best_elements = elements;
+        }
+    }
+    if (best == module->buckets.size()) {
+        return create_status(ET_INVALID_ARGUMENT, "input exceeds the largest shape bucket", func);
+    }
+    *out = best;
+    return nullptr;
+}
+
+// Writes input `index` into the bucket's buffer: the caller's data padded
+// with the pad value, or the generated mask
+static ETStatus* fill_bucket_input(
+    ETModule::BucketInstance& bucket,
+    const ETBucketDim& role,
+    const ETTensor* tensor,
+    int32_t index,
+    const std::vector<int64_t>& actual,
+    const std::vector<ETBucketDim>& dims,
+    const char* func
+) {
+    const auto& shape = bucket.shapes[index];
+    uint8_t* buffer = bucket.buffers[index].data();
+    ETDType dtype = from_scalar_type(bucket.tensors[index]->scalar_type());
+    size_t element_size = dtype_size(dtype);
+
+    if (role.role == ET_BUCKET_MASK) {
+        std::vector<int64_t> extent = shape;
+        for (const auto& dim : dims) {
+            if (dim.index == index) extent[dim.dim] = actual[dim.axis];
+        }
+        fill_elements(buffer, element_count(shape), encode_scalar(0.0, dtype), element_size);
+        fill_block(buffer, shape.data(), extent.data(), shape.size(), encode_scalar(1.0, dtype), element_size);
+        return nullptr;
+    }
+
+    // Only the bucketed dims may differ from the bucket shape
+    bool matches = tensor && tensor->dtype == dtype && static_cast<size_t>(tensor->rank) == shape.size();
+    for (size_t d = 0; matches && d < shape.size(); d++) {
+        bool bucketed = false;
+        for (const auto& dim : dims) bucketed = bucketed || (dim.index == index && dim.dim == static_cast<int32_t>(d));
+        matches = bucketed ? tensor->shape[d] <= shape[d] : tensor->shape[d] == shape[d];
+    }
+    if (!matches) {
+        char msg[128];
+        snprintf(msg, sizeof(msg), "input %d does not match its bucket shape or dtype", index);
+        return create_status(ET_INVALID_ARGUMENT, msg, func);
+    }
+    fill_elements(buffer, element_count(shape), encode_scalar(role.pad_value, dtype), element_size);
+    copy_block(tensor->bytes(), tensor->shape.data(), buffer, shape.data(), shape.size(), element_size);
+    return nullptr;
+}
+
+// Crops the configured dims of output `index` to the actual axis sizes
+static ETTensor* crop_bucket_output(ETTensor* tensor, int32_t index, const std::vector<int64_t>& actual,
+                                    const std::vector<ETBucketDim>& dims) {
+    std::vector<int64_t> shape = tensor->shape;
+    for (const auto& dim : dims) {
+        if (dim.index == index && dim.dim < tensor->rank) shape[dim.dim] = std::min(shape[dim.dim], actual[dim.axis]);
+    }
+    if (shape == tensor->shape) return tensor;
+
+    ETTensor* cropped = new (std::nothrow) ETTensor();
+    if (!cropped) return nullptr;
+    size_t element_size = dtype_size(tensor->dtype);
+    cropped->dtype = tensor->dtype;
+    cropped->rank = tensor->rank;
+    cropped->shape = shape;
+    cropped->data.resize(element_count(shape) * element_size);
+    copy_block(tensor->bytes(), tensor->shape.data(), cropped->data.data(), shape.data(), shape.size(), element_size);
+    return cropped;
+}
+
+ET_API int32_t et_module_bucket_count(const ETModule* module) {
+    if (!module || !module->loaded) return 0;
+    return static_cast<int32_t>(module->buckets.size());
+}
+
+ET_API int64_t et_module_bucket_hits(ETModule* module, int32_t bucket) {
+    if (bucket < 0 || bucket >= et_module_bucket_count(module)) return -1;
+    std::lock_guard<std::mutex> lock(module->mutex);
+    return static_cast<int64_t>(module->buckets[bucket].hits);
+}
+
+/* ============================================================================
+ * Batch Splitting
+ * ============================================================================ */
+
+ET_API ETStatus* et_load_options_set_batch_split(
+    ETLoadOptions* options,
+    int32_t instances,
+    const int32_t* inputs,
+    int32_t input_count
+) {
+    if (!options || instances < 0 || input_count < 0 || (input_count > 0 && !inputs)) {
+        return create_status(ET_INVALID_ARGUMENT, "Invalid argument", __func__);
+    }
+    for (int32_t i = 0; i < input_count; i++) {
+        if (inputs[i] < 0) {
+            return create_status(ET_INVALID_ARGUMENT, "Batch split input index out of range", __func__);
+        }
+    }
+    ET_TRY {
+        options->batch_split_inputs.assign(inputs, inputs + input_count);
+    } ET_CATCH(const std::bad_alloc&, e) {
+        return create_status(ET_OUT_OF_MEMORY, "Failed to store batch split inputs", __func__);
+    }
+    options->batch_instances = instances;
+    return create_ok_status();
+}
+
+// Marks the inputs split along dim 0 - the listed ones, or by default
+// input 0 and every input sharing its dim 0 - reads the model's batch size
+// from the first of them and creates the extra forward instances requested
+// with et_load_options_set_batch_split(). Their methods are not loaded yet.
+static ETStatus* create_batch_instances(ETModule* module, const ETLoadOptions* options, const char* func) {
+    if (!options || options->batch_instances == 0) return nullptr;
+    if (!module->buckets.empty()) {
+        return create_status(ET_INVALID_ARGUMENT, "batch splitting cannot be combined with shape buckets", func);
+    }
+
+    std::shared_ptr<Program> program = module->module->program();
+    if (!program) {
+        return create_status(ET_INTERNAL, "program not loaded", func);
+    }
+    auto meta = program->method_meta("forward");
+    if (!meta.ok() || meta->num_inputs() == 0) {
+        return create_status(ET_INVALID_ARGUMENT, "batch splitting needs forward's input metadata", func);
+    }
+    // Dim 0 of a tensor input, 0 if it has none
+    auto dim0 = [&meta](size_t i) -> int64_t {
+        auto tag = meta->input_tag(i);
+        auto info = meta->input_tensor_meta(i);
+        if (!tag.ok() || *tag != Tag::Tensor || !info.ok() || info->sizes().size() == 0) return 0;
+        return info->sizes()[0];
+    };
+    module->batch_inputs.assign(meta->num_inputs(), false);
+    const auto& listed = options->batch_split_inputs;
+    if (listed.empty()) {
+        module->batch_input = 0;
+        module->batch_size = static_cast<int32_t>(dim0(0));
+        if (module->batch_size <= 0) {
+            module->batch_size = 0;
+            return create_status(ET_INVALID_ARGUMENT, "input 0 has no batch dimension to split", func);
+        }
+        for (size_t i = 0; i < meta->num_inputs(); i++) {
+            module->batch_inputs[i] = dim0(i) == module->batch_size;
+        }
+    } else {
+        for (int32_t index : listed) {
+            char msg[128];
+            if (static_cast<size_t>(index) >= meta->num_inputs()) {
+                snprintf(msg, sizeof(msg), "batch split input %d out of range (forward has %zu inputs)",
+                         index, meta->num_inputs());
+                module->batch_size = 0;
+                return create_status(ET_INVALID_ARGUMENT, msg, func);
+            }
+            int64_t rows = dim0(index);
+            if (module->batch_size == 0) {
+                module->batch_input = index;
+                module->batch_size = static_cast<int32_t>(rows);
+            }
+            if (rows <= 0 || rows != module->batch_size) {
+                if (rows <= 0) {
+                    snprintf(msg, sizeof(msg), "batch split input %d has no batch dimension", index);
+                } else {
+                    snprintf(msg, sizeof(msg), "batch split input %d does not have the batch size of input %d",
+                             index, module->batch_input);
+                }
+                module->batch_size = 0;
+                return create_status(ET_INVALID_ARGUMENT, msg, func);
+            }
+            module->batch_inputs[index] = true;
+        }
+    }
+
+    for (int32_t i = 1; i < options->batch_instances; i++) {
+        ETModule::MethodInstance instance;
+        instance.name = "forward";
+        instance.module = std::make_unique<Module>(program);
+        module->batch_instances.push_back(std::move(instance));
+    }
+    ET_LOG("%s: batches over %d rows split across %d instance(s)", func, module->batch_size,
+           options->batch_instances);
+    return nullptr;
+}
+
+// Runs forward on a batch larger than the model's: dim 0 of the split
+// inputs is cut into batch_size-row chunks that the instances take in turn,
+// and each chunk writes its rows of the concatenated outputs. Full chunks
+// read the caller's rows in place; the last one is zero-padded to
+// batch_size rows. Caller holds module->mutex.
+static ETStatus* split_forward(
+    ETModule* module,
+    ETTensor** inputs,
+    int32_t input_count,
+    ETTensor*** outputs,
+    int32_t* output_count,
+    const char* func
+) {
+    const int64_t batch = inputs[module->batch_input]->shape[0];
+    const int64_t chunk_rows = module->batch_size;
+    std::vector<size_t> row_bytes(input_count, 0);  // 0 = passed to every chunk
+    for (int32_t i = 0; i < input_count; i++) {
+        if (!inputs[i]) {
+            ET_LOG("%s: ERROR - input tensor %d is null", func, i);
+            return create_status(ET_INVALID_ARGUMENT, "input tensor is null", func);
+        }
+        if (static_cast<size_t>(i) >= module->batch_inputs.size() || !module->batch_inputs[i]) continue;
+        if (inputs[i]->rank < 1 || inputs[i]->shape[0] != batch || inputs[i]->nbytes() % batch != 0) {
+            char msg[128];
+            snprintf(msg, sizeof(msg), "input %d does not have the batch size of input %d", i, module->batch_input);
+            return create_status(ET_INVALID_ARGUMENT, msg, func);
+        }
+        row_bytes[i] = inputs[i]->nbytes() / batch;
+    }
+
+    std::vector<Module*> instances{module->module.get()};
+    for (auto& instance : module->batch_instances) instances.push_back(instance.module.get());
+    const int64_t chunk_count = (batch + chunk_rows - 1) / chunk_rows;
+    const size_t worker_count = std::min(instances.size(), static_cast<size_t>(chunk_count));
+    ET_LOG("%s: splitting batch of %lld into %lld chunk(s) on %zu instance(s)", func,
+           static_cast<long long>(batch), static_cast<long long>(chunk_count), worker_count);
+
+    // Concatenated outputs, shaped by the first chunk to finish
+    std::mutex results_mutex;
+    bool results_ready = false;
+    std::vector<std::unique_ptr<ETTensor>> results;
+    std::vector<size_t> result_row_bytes;
+
+    auto run_chunk = [&](Module* instance, int64_t chunk) -> ETStatus* {
+        const int64_t first = chunk * chunk_rows;
+        const int64_t rows = std::min(chunk_rows, batch - first);
+
+        std::vector<std::vector<executorch::aten::SizesType>> sizes(input_count);
+        std::vector<std::vector<uint8_t>> padded(input_count);
+        std::vector<std::unique_ptr<executorch::runtime::etensor::TensorImpl>> tensors(input_count);
+        std::vector<EValue> input_evalues;
+        input_evalues.reserve(input_count);
+        for (int32_t i = 0; i < input_count; i++) {
+            ETTensor* tensor = inputs[i];
+            sizes[i].assign(tensor->shape.begin(), tensor->shape.end());
+            uint8_t* data = tensor->bytes();
+            if (row_bytes[i] > 0) {
+                sizes[i][0] = static_cast<executorch::aten::SizesType>(chunk_rows);
+                data += first * row_bytes[i];
+                if (rows < chunk_rows) {
+                    padded[i].assign(chunk_rows * row_bytes[i], 0);
+                    memcpy(padded[i].data(), data, rows * row_bytes[i]);
+                    data = padded[i].data();
+                }
+            }
+            tensors[i] = std::make_unique<executorch::runtime::etensor::TensorImpl>(
+                to_scalar_type(tensor->dtype), tensor->rank, sizes[i].data(), data);
+            input_evalues.emplace_back(executorch::aten::Tensor(tensors[i].get()));
+        }
+
+        auto result = instance->execute("forward", input_evalues);
+        if (!result.ok()) {
+            char msg[128];
+            snprintf(msg, sizeof(msg), "forward execution failed on rows %lld-%lld (error code: %d)",
+                     static_cast<long long>(first), static_cast<long long>(first + rows - 1),
+                     static_cast<int>(result.error()));
+            return create_status(ET_INFERENCE_FAILED, msg, func);
+        }
+
+        auto& output_evalues = result.get();
+        {
+            std::lock_guard<std::mutex> lock(results_mutex);
+            if (!results_ready) {
+                for (size_t j = 0; j < output_evalues.size(); j++) {
+                    if (!output_evalues[j].isTensor() || output_evalues[j].toTensor().dim() < 1 ||
+                        output_evalues[j].toTensor().size(0) != chunk_rows) {
+                        char msg[128];
+                        snprintf(msg, sizeof(msg), "output %zu has no batch dimension to concatenate", j);
+                        return create_status(ET_UNSUPPORTED, msg, func);
+                    }
+                    const auto& tensor = output_evalues[j].toTensor();
+                    auto concatenated = std::make_unique<ETTensor>();
+                    concatenated->dtype = from_scalar_type(tensor.scalar_type());
+                    concatenated->rank = static_cast<int32_t>(tensor.dim());
+                    concatenated->shape.assign(tensor.sizes().begin(), tensor.sizes().end());
+                    concatenated->shape[0] = batch;
+                    result_row_bytes.push_back(tensor.nbytes() / chunk_rows);
+                    concatenated->data.resize(batch * result_row_bytes.back());
+                    results.push_back(std::move(concatenated));
+                }
+                results_ready = true;
+            }
+        }
+
+        if (output_evalues.size() != results.size()) {
+            return create_status(ET_INFERENCE_FAILED, "chunks returned different output counts", func);
+        }
+        for (size_t j = 0; j < results.size(); j++) {
+            const ETTensor& concatenated = *results[j];
+            bool matches = output_evalues[j].isTensor();
+            if (matches) {
+                const auto& tensor = output_evalues[j].toTensor();
+                matches = from_scalar_type(tensor.scalar_type()) == concatenated.dtype &&
+                          tensor.dim() == concatenated.rank && tensor.size(0) == chunk_rows;
+                for (int32_t d = 1; matches && d < concatenated.rank; d++) {
+                    matches = tensor.size(d) == concatenated.shape[d];
+                }
+            }
+            if (!matches) {
+                char msg[128];
+                snprintf(msg, sizeof(msg), "output %zu differs in shape between chunks", j);
+                return create_status(ET_INFERENCE_FAILED, msg, func);
+            }
+            // Rows of different chunks never overlap
+            memcpy(results[j]->data.data() + first * result_row_bytes[j],
+                   output_evalues[j].toTensor().const_data_ptr(), rows * result_row_bytes[j]);
+        }
+        return nullptr;
+    };
+
+    // Each worker runs on its own instance and takes chunks until they run
+    // out or a chunk fails; worker 0 is the calling thread
+    std::atomic<int64_t> next_chunk{0};
+    std::vector<ETStatus*> errors(worker_count, nullptr);
+    auto worker = [&](size_t index) {
+        for (int64_t chunk = next_chunk++; chunk < chunk_count; chunk = next_chunk++) {
+            ETStatus* error = nullptr;
+            ET_TRY {
+                error = run_chunk(instances[index], chunk);
+            } ET_CATCH(const std::exception&, e) {
+                error = create_status(ET_INFERENCE_FAILED, e.what(), func);
+            } ET_CATCH_ALL {
+                error = create_status(ET_INFERENCE_FAILED, "inference failed with unknown exception", func);
+            }
+            if (error) {
+                errors[index] = error;
+                next_chunk = chunk_count;
+                return;
+            }
+        }
+    };
+    {
+        std::vector<std::thread> workers;
+        struct Joiner {
+            std::vector<std::thread>& threads;
+            ~Joiner() { for (auto& thread : threads) thread.join(); }
+        } joiner{workers};
+        workers.reserve(worker_count - 1);
+        for (size_t i = 1; i < worker_count; i++) {
+            workers.emplace_back([&worker, module, i] {
+                ScopedNodeAffinity node_affinity(module->numa_node);
+                worker(i);
+            });
+        }
+        worker(0);
+    }
+
+    ETStatus* status = nullptr;
+    for (ETStatus* error : errors) {
+        if (!status) {
+            status = error;
+        } else {
+            et_status_free(error);
+        }
+    }
+    if (status) {
+        ET_LOG("%s: ERROR - %s", func, status->message);
+        return status;
+    }
+
+    *output_count = static_cast<int32_t>(results.size());
+    *outputs = static_cast<ETTensor**>(malloc(sizeof(ETTensor*) * results.size()));
+    if (!*outputs && !results.empty()) {
+        *output_count = 0;
+        return create_status(ET_OUT_OF_MEMORY, "failed to allocate outputs array", func);
+    }
+    for (size_t j = 0; j < results.size(); j++) (*outputs)[j] = results[j].release();
+    ET_LOG("%s: SUCCESS - completed forward on %lld rows", func, static_cast<long long>(batch));
+    return create_ok_status();
+}
+
+ET_API int32_t et_module_batch_size(const ETModule* module) {
+    if (!module || !module->loaded) return 0;
+    return module->batch_size;
+}
+
+/* ============================================================================
+ * Module Functions
+ * ============================================================================ */
+
+// Creates an instance, sharing module's program, for every method requested
+// with et_load_options_set_methods() other than forward. Their methods are
+// not loaded yet.
+static ETStatus* create_method_instances(ETModule* module, const ETLoadOptions* options, const char* func) {
+    if (!options || (options->methods.empty() && !options->all_methods)) return nullptr;
+
+    std::shared_ptr<Program> program = module->module->program();
+    if (!program) {
+        return create_status(ET_INTERNAL, "program not loaded", func);
+    }
+    std::vector<std::string> names = options->methods;
+    if (options->all_methods) {
+        names.clear();
+        for (size_t i = 0; i < program->num_methods(); i++) {
+            auto name = program->get_method_name(i);
+            if (name.ok()) names.emplace_back(*name);
+        }
+    }
+
+    for (const auto& name : names) {
+        if (name == "forward") continue;
+        bool duplicate = false;
+        for (const auto& method : module->methods) duplicate = duplicate || method.name == name;
+        if (duplicate) continue;
+        if (!program->method_meta(name.c_str()).ok()) {
+            char msg[512];
+            snprintf(msg, sizeof(msg), "method not found in program: %s", name.c_str());
+            return create_status(ET_INVALID_ARGUMENT, msg, func);
+        }
+        ETModule::MethodInstance method;
+        method.name = name;
+        method.module = std::make_unique<Module>(program);
+        module->methods.push_back(std::move(method));
+    }
+    ET_LOG("%s: %zu methods besides forward, %s init", func, module->methods.size(),
+           options->parallel_init ? "parallel" : "sequential");
+    return nullptr;
+}
+
+static void post_load_progress(const ETLoadOptions& options, const ETModule* module, ETLoadPhase phase,
+                               double elapsed_ms);
+
+// Shared tail of every et_module_load* variant: load the program, read the
+// forward method's metadata, then initialize the method (delegates) with the
+// requested backend options applied. `source` names the model in messages.
+// Each completed phase is reported to the options' progress callback.
+static ETStatus* finish_module_load(
+    ETModule* module,
+    const ETLoadOptions* options,
+    const char* source,
+    const char* func
+) {
+    auto load_start = std::chrono::steady_clock::now();
+    auto report = [&](ETLoadPhase phase) {
+        if (!options || (!options->progress_callback && !options->progress_port)) return;
+        double elapsed_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - load_start).count();
+        if (options->progress_callback) {
+            options->progress_callback(module, phase, elapsed_ms, options->progress_user_data);
+        }
+        if (options->progress_port) post_load_progress(*options, module, phase, elapsed_ms);
+    };
+
+    // Run the load on the target node so that allocations made by the
+    // runtime and the delegates (packed weights) land there too
+    module->numa_node = options ? options->numa_node : -1;
+    module->huge_pages = options ? options->huge_pages : ET_HUGE_PAGES_OFF;
+    ScopedNodeAffinity node_affinity(module->numa_node);
+
+    // Load the program
+    ET_LOG("%s: loading program", func);
+    auto load_error = module->module->load();
+    if (load_error != Error::Ok) {
+        int error_code = static_cast<int>(load_error);
+        ET_LOG("%s: ERROR - failed to load program from: %s, error code: %d", func, source, error_code);
+        char msg[512];
+        snprintf(msg, sizeof(msg), "failed to load program from: %s (error code: %d)", source, error_code);
+        return create_status(ET_MODEL_LOAD_FAILED, msg, func);
+    }
+    report(ET_LOAD_PHASE_PROGRAM_PARSED);
+
+    // Get method metadata; it comes from the program alone, so callers can
+    // act on the I/O specs before the delegates are initialized
+    ET_LOG("%s: getting method metadata", func);
+    auto method_meta_result = module->module->method_meta("forward");
+    if (method_meta_result.ok()) {
+        auto& meta = method_meta_result.get();
+        module->input_count = static_cast<int32_t>(meta.num_inputs());
+        module->output_count = static_cast<int32_t>(meta.num_outputs());
+        ET_LOG("%s: inputs=%d, outputs=%d", func, module->input_count, module->output_count);
+    } else {
+        ET_LOG("%s: WARNING - could not get method metadata, assuming 1 input/output", func);
+        module->input_count = 1;
+        module->output_count = 1;
+    }
+    module->metadata_ready = true;
+    report(ET_LOAD_PHASE_METADATA);
+
+    ETStatus* methods_status = create_method_instances(module, options, func);
+    if (methods_status) return methods_status;
+    ETStatus* buckets_status = create_bucket_instances(module, options, func);
+    if (buckets_status) return buckets_status;
+    ETStatus* batch_status = create_batch_instances(module, options, func);
+    if (batch_status) return batch_status;
+
+    // Load the forward method (this initializes backend delegates like CoreML, MPS)
+    {
+        // Delegates bind to the current threadpool; keep it from being resized.
+        // Lock order: threadpool before backend options (as in thread tuning).
+        std::shared_lock<std::shared_mutex> threadpool_lock(g_threadpool_mutex);
+        module->num_threads = current_thread_count();
+        // Counted before any delegate binds, so a tuning load waiting for the
+        // exclusive lock sees it; ~ETModule releases it, also on failure
+        g_threadpool_module_count++;
+        module->threadpool_bound = true;
+
+        ScopedBackendOptions backend_options;
+        ETStatus* options_status = backend_options.apply(options, func);
+        if (options_status) return options_status;
+
+        ET_LOG("%s: loading forward method (initializing backend delegates)", func);
+        ET_LOG("%s: available backends - XNNPACK: %d, CoreML: %d, Metal: %d, Vulkan: %d",
+               func, ET_BUILD_XNNPACK, ET_BUILD_COREML, ET_BUILD_METAL, ET_BUILD_VULKAN);
+        if (options && options->places_memory() && !place_planned_memory(module, func)) {
+            return create_status(ET_OUT_OF_MEMORY, "failed to allocate placed planned memory", func);
+        }
+        // Each method's delegates initialize independently: with parallel
+        // init the other methods, bucket and batch instances load on their own
+        // threads while forward loads on this one, so cold start approaches
+        // the slowest method
+        std::vector<ETModule::MethodInstance*> instances;
+        for (auto& method : module->methods) instances.push_back(&method);
+        for (auto& bucket : module->buckets) instances.push_back(&bucket.instance);
+        for (auto& batch : module->batch_instances) instances.push_back(&batch);
+        std::vector<Error> method_errors(instances.size(), Error::Ok);
+        auto init_method = [module, &instances, &method_errors](size_t i) {
+            ScopedNodeAffinity method_affinity(module->numa_node);
+            auto& method = *instances[i];
+            auto start = std::chrono::steady_clock::now();
+            ET_TRY {
+                method_errors[i] = method.module->load_method(method.name);
+            } ET_CATCH_ALL {
+                // The load's own ET_CATCH does not cover worker threads
+                method_errors[i] = Error::Internal;
+            }
+            method.init_time_ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+        };
+        bool parallel = options && options->parallel_init;
+        std::vector<std::thread> workers;
+        struct Joiner {
+            std::vector<std::thread>& threads;
+            ~Joiner() { for (auto& thread : threads) thread.join(); }
+        } joiner{workers};
+        if (parallel) {
+            workers.reserve(instances.size());
+            for (size_t i = 0; i < instances.size(); i++) workers.emplace_back(init_method, i);
+        }
+
+        auto forward_start = std::chrono::steady_clock::now();
+        auto forward_error = module->module->load_forward(module->planned_memory.get());
+        module->forward_init_time_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - forward_start).count();
+
+        for (auto& worker : workers) worker.join();
+        workers.clear();
+        if (!parallel && forward_error == Error::Ok) {
+            for (size_t i = 0; i < instances.size(); i++) {
+                init_method(i);
+                if (method_errors[i] != Error::Ok) break;
+            }
+        }
+
+        if (forward_error != Error::Ok) {
+            int error_code = static_cast<int>(forward_error);
+            ET_LOG("%s: ERROR - failed to load forward method, error code: %d", func, error_code);
+            ET_LOG("%s: Model: %s", func, source);
+            ET_LOG("%s: This may indicate a backend delegate initialization failure", func);
+            ET_LOG("%s: Common causes: CoreML delegate not compiled in, model exported for different backend", func);
+            char msg[512];
+            snprintf(msg, sizeof(msg), "failed to load forward method for %s (error code: %d) - check backend compatibility", source, error_code);
+            return create_status(ET_MODEL_LOAD_FAILED, msg, func);
+        }
+        const size_t first_bucket = module->methods.size();
+        const size_t first_batch = first_bucket + module->buckets.size();
+        for (size_t i = 0; i < instances.size(); i++) {
+            std::string name = instances[i]->name;
+            if (i >= first_batch) {
+                name += " (batch instance " + std::to_string(i - first_batch + 1) + ")";
+            } else if (i >= first_bucket) {
+                name += " (bucket " + std::to_string(i - first_bucket) + ")";
+            }
+            if (method_errors[i] != Error::Ok) {
+                int error_code = static_cast<int>(method_errors[i]);
+                ET_LOG("%s: ERROR - failed to load method %s, error code: %d", func, name.c_str(), error_code);
+                char msg[512];
+                snprintf(msg, sizeof(msg), "failed to load method %s for %s (error code: %d)",
+                         name.c_str(), source, error_code);
+                return create_status(ET_MODEL_LOAD_FAILED, msg, func);
+            }
+            ET_LOG("%s: method %s initialized in %.2f ms", func, name.c_str(), instances[i]->init_time_ms);
+        }
+
+        // Still under the shared lock: the warm-up runs use the threadpool
+        if (!module->buckets.empty()) {
+            ETStatus* warm_status = warm_buckets(module, func);
+            if (warm_status) return warm_status;
+        }
+    }
+    report(ET_LOAD_PHASE_DELEGATES_INITIALIZED);
+
+    module->load_time_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - load_start).count();
+    ET_LOG("%s: loaded in %.2f ms", func, module->load_time_ms);
+
+    module->loaded = true;
+    report(ET_LOAD_PHASE_READY);
+    return nullptr;
+}
+
+ET_API ETStatus* et_module_load(
+    const uint8_t* data,
+    size_t data_size,
+    ETModule** out
+) {
+    return et_module_load_with_options(data, data_size, nullptr, out);
+}
+
+ET_API ETStatus* et_module_load_with_options(
+    const uint8_t* data,
+    size_t data_size,
+    const ETLoadOptions* options,
+    ETModule** out
+) {
+    ET_LOG("et_module_load: loading model from buffer, size=%zu bytes", data_size);
+
+    if (!out) {
+        ET_LOG("et_module_load: ERROR - out pointer is null");
+        return create_status(ET_INVALID_ARGUMENT, "out pointer is null", __func__);
+    }
+
+    if (!data || data_size == 0) {
+        ET_LOG("et_module_load: ERROR - invalid model data");
+        return create_status(ET_INVALID_ARGUMENT, "invalid model data", __func__);
+    }
+
+    // Allocate module
+    ETModule* module = new (std::nothrow) ETModule();
+    if (!module) {
+        ET_LOG("et_module_load: ERROR - failed to allocate module");
+        return create_status(ET_OUT_OF_MEMORY, "failed to allocate module", __func__);
+    }
+
+    ET_TRY {
+        // Copy model data to keep it alive for BufferDataLoader
+        ET_LOG("et_module_load: copying model data to internal buffer");
+        int32_t numa_node = options ? options->numa_node : -1;
+        ETHugePages huge_pages = options ? options->huge_pages : ET_HUGE_PAGES_OFF;
+        if (!module->model_buffer.allocate(data_size, numa_node, huge_pages)) {
+            delete module;
+            return create_status(ET_OUT_OF_MEMORY, "failed to allocate model buffer", __func__);
+        }
+        {
+            // Pages are placed on first touch
+            ScopedNodeAffinity node_affinity(numa_node);
+            memcpy(module->model_buffer.data(), data, data_size);
+        }
+
+        // Create BufferDataLoader
+        ET_LOG("et_module_load: creating BufferDataLoader");
+        auto data_loader = std::make_unique<BufferDataLoader>(
+            module->model_buffer.data(),
+            module->model_buffer.size()
         );
 
-        // Load the program
-        ET_LOG("et_module_load_file: loading program");
-        auto load_error = module->module->load();
-        if (load_error != Error::Ok) {
-            int error_code = static_cast<int>(load_error);
-            ET_LOG("et_module_load_file: ERROR - failed to load program from: %s, error code: %d", path, error_code);
-            delete module;
-            char msg[512];
-            snprintf(msg, sizeof(msg), "failed to load program from: %s (error code: %d)", path, error_code);
-            return create_status(ET_MODEL_LOAD_FAILED, msg, __func__);
-        }
+        // Create Module with the data loader
+        ET_LOG("et_module_load: creating Module");
+        module->module = std::make_unique<Module>(std::move(data_loader));
+
+        if (options && options->tune_threads) {
+            tune_thread_count(module, *options, nullptr);
+        }
+
+        ETStatus* error = finish_module_load(module, options, "buffer", "et_module_load");
+        if (error) {
+            delete module;
+            return error;
+        }
+
+        *out = module;
+        ET_LOG("et_module_load: SUCCESS - module loaded at %p", static_cast<void*>(module));
+        return create_ok_status();
+
+    } ET_CATCH(const std::exception&, e) {
+        ET_LOG("et_module_load: ERROR - C++ exception: %s", e.what());
+        delete module;
+        char msg[512];
+        snprintf(msg, sizeof(msg), "backend initialization failed: %s", e.what());
+        return create_status(ET_MODEL_LOAD_FAILED, msg, __func__);
+    } ET_CATCH_ALL {
+        ET_LOG("et_module_load: ERROR - unknown C++ exception");
+        delete module;
+        return create_status(ET_MODEL_LOAD_FAILED, "unknown backend initialization error", __func__);
+    }
+}
+
+static ETStatus* read_file_placed(const char* path, const ETLoadOptions& options, ETModule* module) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        char msg[512];
+        snprintf(msg, sizeof(msg), "failed to open model file: %s", path);
+        return create_status(ET_IO_ERROR, msg, "et_module_load_file");
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    ETStatus* error = nullptr;
+    if (size <= 0 || !module->model_buffer.allocate(static_cast<size_t>(size), options.numa_node, options.huge_pages)) {
+        error = create_status(ET_OUT_OF_MEMORY, "failed to allocate model buffer", "et_module_load_file");
+    } else {
+        ScopedNodeAffinity node_affinity(options.numa_node);
+        if (fread(module->model_buffer.data(), 1, module->model_buffer.size(), file) != module->model_buffer.size()) {
+            error = create_status(ET_IO_ERROR, "failed to read model file", "et_module_load_file");
+        }
+    }
+    fclose(file);
+    return error;
+}
+
+ET_API ETStatus* et_module_load_file(
+    const char* path,
+    ETModule** out
+) {
+    return et_module_load_file_with_options(path, nullptr, out);
+}
+
+ET_API ETStatus* et_module_load_file_with_options(
+    const char* path,
+    const ETLoadOptions* options,
+    ETModule** out
+) {
+    ET_LOG("et_module_load_file: loading model from file: %s", path ? path : "(null)");
+
+    if (!out) {
+        ET_LOG("et_module_load_file: ERROR - out pointer is null");
+        return create_status(ET_INVALID_ARGUMENT, "out pointer is null", __func__);
+    }
+
+    if (!path) {
+        ET_LOG("et_module_load_file: ERROR - path is null");
+        return create_status(ET_INVALID_ARGUMENT, "path is null", __func__);
+    }
+
+    // Allocate module
+    ETModule* module = new (std::nothrow) ETModule();
+    if (!module) {
+        ET_LOG("et_module_load_file: ERROR - failed to allocate module");
+        return create_status(ET_OUT_OF_MEMORY, "failed to allocate module", __func__);
+    }
+
+    ET_TRY {
+        if (options && options->places_memory()) {
+            // A shared file mapping lives in the page cache, on whichever node
+            // first read it and in base pages; copy the program instead
+            ET_LOG("et_module_load_file: reading model into placed memory (node %d, huge pages %d)",
+                   options->numa_node, static_cast<int>(options->huge_pages));
+            ETStatus* read_error = read_file_placed(path, *options, module);
+            if (read_error) {
+                delete module;
+                return read_error;
+            }
+            module->module = std::make_unique<Module>(std::make_unique<BufferDataLoader>(
+                module->model_buffer.data(), module->model_buffer.size()));
+        } else {
+            // Create Module directly from file path
+            ET_LOG("et_module_load_file: creating Module with MmapUseMlockIgnoreErrors");
+            module->module = std::make_unique<Module>(
+                std::string(path),
+                Module::LoadMode::MmapUseMlockIgnoreErrors
+            );
+        }
+
+        if (options && options->tune_threads) {
+            tune_thread_count(module, *options, path);
+        }
+
+        ETStatus* error = finish_module_load(module, options, path, "et_module_load_file");
+        if (error) {
+            delete module;
+            return error;
+        }
+
+        *out = module;
+        ET_LOG("et_module_load_file: SUCCESS - module loaded at %p", static_cast<void*>(module));
+        return create_ok_status();
+
+    } ET_CATCH(const std::exception&, e) {
+        ET_LOG("et_module_load_file: ERROR - C++ exception: %s", e.what());
+        delete module;
+        char msg[512];
+        snprintf(msg, sizeof(msg), "backend initialization failed: %s", e.what());
+        return create_status(ET_MODEL_LOAD_FAILED, msg, __func__);
+    } ET_CATCH_ALL {
+        ET_LOG("et_module_load_file: ERROR - unknown C++ exception");
+        delete module;
+        return create_status(ET_MODEL_LOAD_FAILED, "unknown backend initialization error", __func__);
+    }
+}
+
+// Whether forward delegates to `backend`, so et_module_backend() reports
+// what the program actually runs on rather than what the caller declared
+static bool delegates_to(ETModule* module, ETBackend backend) {
+    if (backend == ET_BACKEND_PORTABLE) return true;
+    auto meta = module->module->method_meta("forward");
+    return meta.ok() && meta->uses_backend(backend_registry_name(backend));
+}
+
+ET_API ETStatus* et_module_load_preferred(
+    const ETModelVariant* variants,
+    int32_t variant_count,
+    const ETLoadOptions* options,
+    ETModule** out
+) {
+    ET_LOG("et_module_load_preferred: %d variant(s)", variant_count);
+
+    if (!out) {
+        return create_status(ET_INVALID_ARGUMENT, "out pointer is null", __func__);
+    }
+    if (!variants || variant_count <= 0) {
+        return create_status(ET_INVALID_ARGUMENT, "no model variants given", __func__);
+    }
+
+    // Options for a backend that is not built in would fail every variant,
+    // including those that never use it (CoreML options on Linux fail the
+    // XNNPACK variant), so they are dropped here
+    std::unique_ptr<ETLoadOptions> variant_options;
+    if (options) {
+        ET_TRY {
+            variant_options = std::make_unique<ETLoadOptions>(*options);
+        } ET_CATCH(const std::bad_alloc&, e) {
+            return create_status(ET_OUT_OF_MEMORY, "Failed to copy load options", __func__);
+        }
+        auto& backend_options = variant_options->backend_options;
+        for (auto it = backend_options.begin(); it != backend_options.end();) {
+            if (get_backend_class(backend_registry_name(it->first))) {
+                ++it;
+                continue;
+            }
+            ET_LOG("et_module_load_preferred: ignoring options for %s, which is not built in",
+                   backend_display_name(it->first));
+            it = backend_options.erase(it);
+        }
+    }
+
+    std::string failures;
+    for (int32_t i = 0; i < variant_count; i++) {
+        const ETModelVariant& variant = variants[i];
+        const char* name = backend_display_name(variant.backend);
+        char reason[512];
+
+        if (!backend_runtime_available(variant.backend)) {
+            snprintf(reason, sizeof(reason), "backend not available");
+        } else {
+            ETModule* module = nullptr;
+            ETStatus* status = variant.path
+                ? et_module_load_file_with_options(variant.path, variant_options.get(), &module)
+                : et_module_load_with_options(variant.data, variant.data_size, variant_options.get(), &module);
+
+            if (module && !delegates_to(module, variant.backend)) {
+                et_module_free(module);
+                module = nullptr;
+                et_status_free(status);
+                status = create_status(ET_MODEL_LOAD_FAILED, "model is not delegated to this backend", __func__);
+            }
+            if (module) {
+                et_status_free(status);
+                module->backend = variant.backend;
+                *out = module;
+                ET_LOG("et_module_load_preferred: selected variant %d (%s), load took %.2f ms",
+                       i, name, module->load_time_ms);
+                return create_ok_status();
+            }
+            snprintf(reason, sizeof(reason), "%s",
+                     status && status->message ? status->message : "load failed");
+            et_status_free(status);
+        }
+
+        ET_LOG("et_module_load_preferred: variant %d (%s) rejected: %s", i, name, reason);
+        failures += "\n  [" + std::to_string(i) + "] " + name + ": " + reason;
+    }
+
+    std::string msg = "no model variant could be loaded:" + failures;
+    return create_status(ET_MODEL_LOAD_FAILED, msg.c_str(), __func__);
+}
+
+ET_API int32_t et_module_backend(const ETModule* module) {
+    if (!module || !module->loaded) return -1;
+    return module->backend;
+}
+
+ET_API double et_module_load_time_ms(const ETModule* module) {
+    if (!module) return 0.0;
+    return module->load_time_ms;
+}
+
+ET_API int32_t et_module_method_count(const ETModule* module) {
+    if (!module || !module->loaded) return 0;
+    return 1 + static_cast<int32_t>(module->methods.size());
+}
+
+ET_API const char* et_module_method_name(const ETModule* module, int32_t index) {
+    if (index < 0 || index >= et_module_method_count(module)) return nullptr;
+    return index == 0 ? "forward" : module->methods[index - 1].name.c_str();
+}
+
+ET_API double et_module_method_init_time_ms(const ETModule* module, const char* method_name) {
+    if (!module || !module->loaded || !method_name) return -1.0;
+    if (strcmp(method_name, "forward") == 0) return module->forward_init_time_ms;
+    for (const auto& method : module->methods) {
+        if (method.name == method_name) return method.init_time_ms;
+    }
+    return -1.0;
+}
+
+ET_API int32_t et_module_num_threads(const ETModule* module) {
+    if (!module || !module->loaded) return 0;
+    return module->num_threads;
+}
+
+ET_API int32_t et_module_thread_tuned(const ETModule* module) {
+    if (!module || !module->loaded) return 0;
+    return module->thread_tuned ? 1 : 0;
+}
+
+ET_API int32_t et_module_numa_node(const ETModule* module) {
+    if (!module || !module->loaded) return -1;
+    return module->numa_node;
+}
+
+ET_API double et_module_huge_page_fraction(const ETModule* module) {
+    if (!module || !module->loaded) return 0.0;
+    std::vector<const PlacedBuffer*> buffers;
+    size_t total = 0;
+    if (module->model_buffer.data()) {
+        buffers.push_back(&module->model_buffer);
+        total += module->model_buffer.size();
+    }
+    for (const auto& buffer : module->planned_buffers) {
+        buffers.push_back(&buffer);
+        total += buffer.size();
+    }
+    if (total == 0) return 0.0;
+    return std::min(1.0, static_cast<double>(huge_page_backed_bytes(buffers)) / static_cast<double>(total));
+}
+
+ET_API int32_t et_module_input_count(const ETModule* module) {
+    if (!module || !module->metadata_ready) return 0;
+    return module->input_count;
+}
+
+ET_API int32_t et_module_output_count(const ETModule* module) {
+    if (!module || !module->metadata_ready) return 0;
+    return module->output_count;
+}
+
+static ETStatus* tensor_spec(const ETModule* module, int32_t index, bool input, ETTensorSpec* out, const char* func) {
+    if (!module || !module->metadata_ready) {
+        return create_status(ET_INVALID_STATE, "module not loaded", func);
+    }
+    if (!out) {
+        return create_status(ET_INVALID_ARGUMENT, "out pointer is null", func);
+    }
+    if (index < 0 || index >= (input ? module->input_count : module->output_count)) {
+        return create_status(ET_INVALID_ARGUMENT, "index out of range", func);
+    }
+
+    auto meta = module->module->method_meta("forward");
+    if (!meta.ok()) {
+        return create_status(ET_INVALID_STATE, "method metadata unavailable", func);
+    }
+    auto tag = input ? meta->input_tag(index) : meta->output_tag(index);
+    if (!tag.ok() || *tag != Tag::Tensor) {
+        return create_status(ET_UNSUPPORTED, "not a tensor", func);
+    }
+    auto info = input ? meta->input_tensor_meta(index) : meta->output_tensor_meta(index);
+    if (!info.ok()) {
+        return create_status(ET_INTERNAL, "tensor metadata unavailable", func);
+    }
+
+    auto sizes = info->sizes();
+    if (sizes.size() > ET_MAX_RANK) {
+        return create_status(ET_UNSUPPORTED, "rank exceeds ET_MAX_RANK", func);
+    }
+    memset(out, 0, sizeof(*out));
+    out->dtype = from_scalar_type(info->scalar_type());
+    out->rank = static_cast<int32_t>(sizes.size());
+    for (size_t i = 0; i < sizes.size(); i++) out->shape[i] = sizes[i];
+    out->nbytes = info->nbytes();
+    out->memory_planned = info->is_memory_planned() ? 1 : 0;
+    return create_ok_status();
+}
+
+ET_API ETStatus* et_module_input_spec(const ETModule* module, int32_t index, ETTensorSpec* out) {
+    return tensor_spec(module, index, true, out, __func__);
+}
+
+ET_API ETStatus* et_module_output_spec(const ETModule* module, int32_t index, ETTensorSpec* out) {
+    return tensor_spec(module, index, false, out, __func__);
+}
+
+ET_API ETStatus* et_module_bind_output(ETModule* module, int32_t index, const ETTensor* tensor) {
+    if (!module || !module->loaded) {
+        return create_status(ET_INVALID_STATE, "module not loaded", __func__);
+    }
+    if (!tensor || !tensor->shared) {
+        return create_status(ET_INVALID_ARGUMENT, "tensor is not a shared-memory tensor", __func__);
+    }
+    if (index < 0 || index >= module->output_count) {
+        return create_status(ET_INVALID_ARGUMENT, "output index out of range", __func__);
+    }
+    if (!module->buckets.empty()) {
+        return create_status(ET_UNSUPPORTED, "outputs cannot be bound with shape buckets", __func__);
+    }
+    if (module->batch_size > 0) {
+        return create_status(ET_UNSUPPORTED, "outputs cannot be bound with batch splitting", __func__);
+    }
+
+    std::lock_guard<std::mutex> lock(module->mutex);
 
-        // Load the forward method (this initializes backend delegates like CoreML, MPS)
-        ET_LOG("et_module_load_file: loading forward method (initializing backend delegates)");
-        ET_LOG("et_module_load_file: available backends - XNNPACK: %d, CoreML: %d, Metal: %d, Vulkan: %d",
-               ET_BUILD_XNNPACK, ET_BUILD_COREML, ET_BUILD_METAL, ET_BUILD_VULKAN);
-        auto forward_error = module->module->load_forward();
-        if (forward_error != Error::Ok) {
-            int error_code = static_cast<int>(forward_error);
-            ET_LOG("et_module_load_file: ERROR - failed to load forward method, error code: %d", error_code);
-            ET_LOG("et_module_load_file: Model path: %s", path);
-            ET_LOG("et_module_load_file: This may indicate a backend delegate initialization failure");
-            ET_LOG("et_module_load_file: Common causes: CoreML delegate not compiled in, model exported for different backend");
-            delete module;
-            char msg[512];
-            snprintf(msg, sizeof(msg), "failed to load forward method for %s (error code: %d) - check backend compatibility", path, error_code);
-            return create_status(ET_MODEL_LOAD_FAILED, msg, __func__);
-        }
-
-        // Get method metadata
-        ET_LOG("et_module_load_file: getting method metadata");
-        auto method_meta_result = module->module->method_meta("forward");
-        if (method_meta_result.ok()) {
-            auto& meta = method_meta_result.get();
-            module->input_count = static_cast<int32_t>(meta.num_inputs());
-            module->output_count = static_cast<int32_t>(meta.num_outputs());
-            ET_LOG("et_module_load_file: inputs=%d, outputs=%d", module->input_count, module->output_count);
-        } else {
-            ET_LOG("et_module_load_file: WARNING - could not get method metadata, assuming 1 input/output");
-            module->input_count = 1;
-            module->output_count = 1;
+    ET_TRY {
+        // The method only takes the data pointer and byte size; the TensorImpl
+        // is just the carrier for them
+        std::vector<executorch::aten::SizesType> sizes(tensor->shape.begin(), tensor->shape.end());
+        executorch::runtime::etensor::TensorImpl impl(
+            to_scalar_type(tensor->dtype),
+            tensor->rank,
+            sizes.data(),
+            tensor->shared->data
+        );
+        Error err = module->module->set_output("forward", EValue(executorch::aten::Tensor(&impl)), index);
+        if (err != Error::Ok) {
+            char msg[256];
+            if (err == Error::InvalidState) {
+                snprintf(msg, sizeof(msg),
+                         "output %d is memory-planned; export the model with alloc_graph_output=False "
+                         "to bind it", index);
+                return create_status(ET_UNSUPPORTED, msg, __func__);
+            }
+            snprintf(msg, sizeof(msg), "failed to bind output %d (error 0x%x)", index, static_cast<unsigned>(err));
+            return create_status(ET_INVALID_ARGUMENT, msg, __func__);
         }
 
-        module->loaded = true;
-        *out = module;
-        ET_LOG("et_module_load_file: SUCCESS - module loaded at %p", static_cast<void*>(module));
+        if (module->bound_outputs.size() < static_cast<size_t>(module->output_count)) {
+            module->bound_outputs.resize(module->output_count);
+        }
+        module->bound_outputs[index] = tensor->shared;
+        ET_LOG("et_module_bind_output: output %d -> fd %d", index, tensor->shared->fd);
         return create_ok_status();
 
-    } catch (const std::exception& e) {
-        ET_LOG("et_module_load_file: ERROR - C++ exception: %s", e.what());
-        delete module;
-        char msg[512];
-        snprintf(msg, sizeof(msg), "backend initialization failed: %s", e.what());
-        return create_status(ET_MODEL_LOAD_FAILED, msg, __func__);
-    } catch (...) {
-        ET_LOG("et_module_load_file: ERROR - unknown C++ exception");
-        delete module;
-        return create_status(ET_MODEL_LOAD_FAILED, "unknown backend initialization error", __func__);
+    } ET_CATCH(const std::exception&, e) {
+        return create_status(ET_INTERNAL, e.what(), __func__);
+    } ET_CATCH_ALL {
+        return create_status(ET_INTERNAL, "unknown C++ exception", __func__);
     }
 }
 
-ET_API int32_t et_module_input_count(const ETModule* module) {
-    if (!module || !module->loaded) return 0;
-    return module->input_count;
-}
-
-ET_API int32_t et_module_output_count(const ETModule* module) {
-    if (!module || !module->loaded) return 0;
-    return module->output_count;
-}
-
-ET_API ETStatus* et_module_forward(
+// Runs `method_name` - forward or one of the methods initialized with
+// et_load_options_set_methods() - and converts its outputs.
+static ETStatus* execute_method(
     ETModule* module,
+    const char* method_name,
     ETTensor** inputs,
     int32_t input_count,
     ETTensor*** outputs,
-    int32_t* output_count
+    int32_t* output_count,
+    const char* func
 ) {
-    ET_LOG("et_module_forward: starting forward pass with %d inputs", input_count);
+    ET_LOG("%s: running %s with %d inputs", func, method_name, input_count);
 
     if (!module || !module->loaded) {
-        ET_LOG("et_module_forward: ERROR - module not loaded");
-        return create_status(ET_INVALID_STATE, "module not loaded", __func__);
+        ET_LOG("%s: ERROR - module not loaded", func);
+        return create_status(ET_INVALID_STATE, "module not loaded", func);
     }
 
     if (!outputs || !output_count) {
-        ET_LOG("et_module_forward: ERROR - invalid output pointers");
-        return create_status(ET_INVALID_ARGUMENT, "invalid output pointers", __func__);
+        ET_LOG("%s: ERROR - invalid output pointers", func);
+        return create_status(ET_INVALID_ARGUMENT, "invalid output pointers", func);
     }
 
     if (input_count > 0 && !inputs) {
-        ET_LOG("et_module_forward: ERROR - inputs is null");
-        return create_status(ET_INVALID_ARGUMENT, "inputs is null", __func__);
+        ET_LOG("%s: ERROR - inputs is null", func);
+        return create_status(ET_INVALID_ARGUMENT, "inputs is null", func);
+    }
+
+    // Forward runs on the module itself, other methods on their instance
+    bool is_forward = strcmp(method_name, "forward") == 0;
+    Module* target = is_forward ? module->module.get() : nullptr;
+    for (auto& method : module->methods) {
+        if (!target && method.name == method_name) target = method.module.get();
+    }
+    if (!target) {
+        ET_LOG("%s: ERROR - method %s not initialized", func, method_name);
+        return create_status(ET_INVALID_ARGUMENT, "method not initialized (see et_load_options_set_methods)", func);
     }
 
     std::lock_guard<std::mutex> lock(module->mutex);
+    ScopedNodeAffinity node_affinity(module->numa_node);
+
+    ET_TRY {
+        // Batches larger than the model's are split across the batch instances
+        const int32_t batch_input = module->batch_input;
+        if (is_forward && module->batch_size > 0 && batch_input < input_count && inputs[batch_input] &&
+            inputs[batch_input]->rank > 0 && inputs[batch_input]->shape[0] > module->batch_size) {
+            return split_forward(module, inputs, input_count, outputs, output_count, func);
+        }
+
+        // With shape buckets, forward runs on the instance of the smallest
+        // bucket the inputs fit
+        ETModule::BucketInstance* bucket = nullptr;
+        std::vector<int64_t> actual_sizes;
+        if (is_forward && !module->buckets.empty()) {
+            size_t bucket_index = 0;
+            ETStatus* error = select_bucket(module, inputs, input_count, actual_sizes, &bucket_index, func);
+            if (error) return error;
+            bucket = &module->buckets[bucket_index];
+            bucket->hits++;
+            target = bucket->instance.module.get();
+            ET_LOG("%s: using shape bucket %zu", func, bucket_index);
+        }
 
-    try {
         // Clear previous input storage (will be repopulated during conversion)
-        ET_LOG("et_module_forward: clearing previous input storage");
+        ET_LOG("%s: clearing previous input storage", func);
         module->input_sizes_storage.clear();
         module->input_data_storage.clear();
 
         // Convert input tensors to EValues (stores data in module to keep alive)
-        ET_LOG("et_module_forward: converting %d input tensors", input_count);
+        ET_LOG("%s: converting %d input tensors", func, input_count);
         std::vector<EValue> input_evalues;
         input_evalues.reserve(input_count);
 
         for (int32_t i = 0; i < input_count; i++) {
+            const ETBucketDim* role = bucket ? bucket_input_role(module, i) : nullptr;
+            if (role) {
+                // Padded into the bucket's own buffer, bound to its tensor
+                ETStatus* error = fill_bucket_input(*bucket, *role, inputs[i], i, actual_sizes,
+                                                    module->bucket_inputs, func);
+                if (error) return error;
+                input_evalues.emplace_back(executorch::aten::Tensor(bucket->tensors[i].get()));
+                continue;
+            }
             if (!inputs[i]) {
-                ET_LOG("et_module_forward: ERROR - input tensor %d is null", i);
-                return create_status(ET_INVALID_ARGUMENT, "input tensor is null", __func__);
+                ET_LOG("%s: ERROR - input tensor %d is null", func, i);
+                return create_status(ET_INVALID_ARGUMENT, "input tensor is null", func);
             }
             // Pass module so tensor data is stored and kept alive
             input_evalues.push_back(tensor_to_evalue(inputs[i], module, i));
         }
 
-        // Execute forward
-        ET_LOG("et_module_forward: executing forward");
-        auto result = module->module->forward(input_evalues);
+        // Execute the method
+        ET_LOG("%s: executing %s", func, method_name);
+        auto result = target->execute(method_name, input_evalues);
         if (!result.ok()) {
-            ET_LOG("et_module_forward: ERROR - forward execution failed");
-            return create_status(ET_INFERENCE_FAILED, "forward execution failed", __func__);
+            ET_LOG("%s: ERROR - %s execution failed", func, method_name);
+            char msg[256];
+            snprintf(msg, sizeof(msg), "%s execution failed", method_name);
+            return create_status(ET_INFERENCE_FAILED, msg, func);
         }
 
         auto& output_evalues = result.get();
         *output_count = static_cast<int32_t>(output_evalues.size());
-        ET_LOG("et_module_forward: forward returned %d outputs", *output_count);
+        ET_LOG("%s: %s returned %d outputs", func, method_name, *output_count);
 
         // Allocate output array
         *outputs = static_cast<ETTensor**>(malloc(sizeof(ETTensor*) * (*output_count)));
         if (!*outputs) {
-            ET_LOG("et_module_forward: ERROR - failed to allocate outputs array");
-            return create_status(ET_OUT_OF_MEMORY, "failed to allocate outputs array", __func__);
+            ET_LOG("%s: ERROR - failed to allocate outputs array", func);
+            return create_status(ET_OUT_OF_MEMORY, "failed to allocate outputs array", func);
         }
 
         // Convert output EValues to ETTensors
-        ET_LOG("et_module_forward: converting %d output tensors", *output_count);
+        ET_LOG("%s: converting %d output tensors", func, *output_count);
         for (int32_t i = 0; i < *output_count; i++) {
-            ETTensor* out_tensor = evalue_to_tensor(output_evalues[i], i);
+            ETTensor* out_tensor = nullptr;
+            if (is_forward && !bucket && static_cast<size_t>(i) < module->bound_outputs.size()) {
+                out_tensor = shared_output_view(output_evalues[i], module->bound_outputs[i], i);
+            }
+            if (!out_tensor) out_tensor = evalue_to_tensor(output_evalues[i], i);
+            if (out_tensor && bucket && !module->bucket_outputs.empty()) {
+                ETTensor* cropped = crop_bucket_output(out_tensor, i, actual_sizes, module->bucket_outputs);
+                if (cropped != out_tensor) delete out_tensor;
+                out_tensor = cropped;
+            }
             if (!out_tensor) {
-                ET_LOG("et_module_forward: ERROR - failed to convert output tensor %d", i);
+                ET_LOG("%s: ERROR - failed to convert output tensor %d", func, i);
                 // Clean up
                 for (int32_t j = 0; j < i; j++) {
                     delete (*outputs)[j];
@@ -609,23 +3457,47 @@ ET_API ETStatus* et_module_forward(
                 free(*outputs);
                 *outputs = nullptr;
                 *output_count = 0;
-                return create_status(ET_INFERENCE_FAILED, "failed to convert output tensor", __func__);
+                return create_status(ET_INFERENCE_FAILED, "failed to convert output tensor", func);
             }
             (*outputs)[i] = out_tensor;
         }
 
-        ET_LOG("et_module_forward: SUCCESS - completed forward pass");
+        ET_LOG("%s: SUCCESS - completed %s", func, method_name);
         return create_ok_status();
 
-    } catch (const std::exception& e) {
-        ET_LOG("et_module_forward: ERROR - C++ exception: %s", e.what());
+    } ET_CATCH(const std::exception&, e) {
+        ET_LOG("%s: ERROR - C++ exception: %s", func, e.what());
         char msg[512];
         snprintf(msg, sizeof(msg), "inference failed with exception: %s", e.what());
-        return create_status(ET_INFERENCE_FAILED, msg, __func__);
-    } catch (...) {
-        ET_LOG("et_module_forward: ERROR - unknown C++ exception");
-        return create_status(ET_INFERENCE_FAILED, "inference failed with unknown exception", __func__);
+        return create_status(ET_INFERENCE_FAILED, msg, func);
+    } ET_CATCH_ALL {
+        ET_LOG("%s: ERROR - unknown C++ exception", func);
+        return create_status(ET_INFERENCE_FAILED, "inference failed with unknown exception", func);
+    }
+}
+
+ET_API ETStatus* et_module_forward(
+    ETModule* module,
+    ETTensor** inputs,
+    int32_t input_count,
+    ETTensor*** outputs,
+    int32_t* output_count
+) {
+    return execute_method(module, "forward", inputs, input_count, outputs, output_count, __func__);
+}
+
+ET_API ETStatus* et_module_execute(
+    ETModule* module,
+    const char* method_name,
+    ETTensor** inputs,
+    int32_t input_count,
+    ETTensor*** outputs,
+    int32_t* output_count
+) {
+    if (!method_name) {
+        return create_status(ET_INVALID_ARGUMENT, "method name is null", __func__);
     }
+    return execute_method(module, method_name, inputs, input_count, outputs, output_count, __func__);
 }
 
 ET_API void et_module_free(ETModule* module) {
@@ -655,22 +3527,35 @@ ET_API void et_module_free(ETModule* module) {
  * marshals it onto the Dart event loop automatically.
  * ============================================================================ */
 
-#include <thread>
+// Copy of the caller's options for use after the entry point returns
+static std::unique_ptr<ETLoadOptions> copy_load_options(const ETLoadOptions* options) {
+    return options ? std::make_unique<ETLoadOptions>(*options) : nullptr;
+}
 
 ET_API void et_module_load_async(
     const uint8_t* data,
     size_t data_size,
     ETModule** out,
     ETCallback_1 callback
+) {
+    et_module_load_async_with_options(data, data_size, nullptr, out, callback);
+}
+
+ET_API void et_module_load_async_with_options(
+    const uint8_t* data,
+    size_t data_size,
+    const ETLoadOptions* options,
+    ETModule** out,
+    ETCallback_1 callback
 ) {
     ET_LOG("et_module_load_async: spawning thread, size=%zu bytes", data_size);
 
-    // Copy data so caller can free immediately
+    // Copy data and options so caller can free immediately
     std::vector<uint8_t> data_copy(data, data + data_size);
 
-    std::thread([data_copy = std::move(data_copy), out, callback]() {
+    std::thread([data_copy = std::move(data_copy), options_copy = copy_load_options(options), out, callback]() {
         ET_LOG("et_module_load_async: thread started");
-        ETStatus* status = et_module_load(data_copy.data(), data_copy.size(), out);
+        ETStatus* status = et_module_load_with_options(data_copy.data(), data_copy.size(), options_copy.get(), out);
         ET_LOG("et_module_load_async: load done, calling callback");
         if (callback) callback(status);
     }).detach();
@@ -680,15 +3565,24 @@ ET_API void et_module_load_file_async(
     const char* path,
     ETModule** out,
     ETCallback_1 callback
+) {
+    et_module_load_file_async_with_options(path, nullptr, out, callback);
+}
+
+ET_API void et_module_load_file_async_with_options(
+    const char* path,
+    const ETLoadOptions* options,
+    ETModule** out,
+    ETCallback_1 callback
 ) {
     ET_LOG("et_module_load_file_async: spawning thread, path=%s", path ? path : "(null)");
 
-    // Copy path so caller can free immediately
+    // Copy path and options so caller can free immediately
     std::string path_copy(path ? path : "");
 
-    std::thread([path_copy = std::move(path_copy), out, callback]() {
+    std::thread([path_copy = std::move(path_copy), options_copy = copy_load_options(options), out, callback]() {
         ET_LOG("et_module_load_file_async: thread started");
-        ETStatus* status = et_module_load_file(path_copy.c_str(), out);
+        ETStatus* status = et_module_load_file_with_options(path_copy.c_str(), options_copy.get(), out);
         ET_LOG("et_module_load_file_async: load done, calling callback");
         if (callback) callback(status);
     }).detach();
@@ -712,6 +3606,183 @@ ET_API void et_module_forward_async(
     }).detach();
 }
 
+/* ============================================================================
+ * Dart Native Port Functions
+ * ============================================================================ */
+
+static std::atomic<ETDartPostCObjectFn> g_dart_post_cobject{nullptr};
+
+ET_API void et_dart_init(ETDartPostCObjectFn post_cobject) {
+    g_dart_post_cobject.store(post_cobject);
+}
+
+// Posts [request_id, code, status, handles...] as one Int64List. Dart copies
+// typed data while posting, so the payload can live on this thread's stack.
+// On success the receiver owns the status and handles.
+static bool post_completion(int64_t port, int64_t request_id, ETStatus* status, const std::vector<int64_t>& handles) {
+    ETDartPostCObjectFn post = g_dart_post_cobject.load();
+    std::vector<int64_t> payload;
+    payload.reserve(3 + handles.size());
+    payload.push_back(request_id);
+    payload.push_back(status ? status->code : ET_OUT_OF_MEMORY);
+    payload.push_back(status && status->code != ET_OK ? static_cast<int64_t>(reinterpret_cast<intptr_t>(status)) : 0);
+    payload.insert(payload.end(), handles.begin(), handles.end());
+
+    ETDartCObject message;
+    message.type = ET_DART_COBJECT_TYPED_DATA;
+    message.value.as_typed_data.type = ET_DART_TYPED_DATA_INT64;
+    message.value.as_typed_data.length = static_cast<intptr_t>(payload.size());
+    message.value.as_typed_data.values = reinterpret_cast<const uint8_t*>(payload.data());
+
+    bool posted = post && post(port, &message) != 0;
+    if (!posted) {
+        ET_LOG("dart port %lld: post failed (port closed?), dropping completion %lld",
+               static_cast<long long>(port), static_cast<long long>(request_id));
+        et_status_free(status);
+    } else if (status && status->code == ET_OK) {
+        et_status_free(status);
+    }
+    return posted;
+}
+
+// Posts [request_id, phase, elapsed_us, input_count, output_count] to the
+// options' progress port; a failed post only drops the message
+static void post_load_progress(const ETLoadOptions& options, const ETModule* module, ETLoadPhase phase,
+                               double elapsed_ms) {
+    ETDartPostCObjectFn post = g_dart_post_cobject.load();
+    if (!post) return;
+    bool metadata = module->metadata_ready;
+    int64_t payload[5] = {
+        options.progress_request_id,
+        phase,
+        static_cast<int64_t>(elapsed_ms * 1000.0),
+        metadata ? module->input_count : -1,
+        metadata ? module->output_count : -1,
+    };
+
+    ETDartCObject message;
+    message.type = ET_DART_COBJECT_TYPED_DATA;
+    message.value.as_typed_data.type = ET_DART_TYPED_DATA_INT64;
+    message.value.as_typed_data.length = 5;
+    message.value.as_typed_data.values = reinterpret_cast<const uint8_t*>(payload);
+    if (post(options.progress_port, &message) == 0) {
+        ET_LOG("dart port %lld: post failed (port closed?), dropping load progress",
+               static_cast<long long>(options.progress_port));
+    }
+}
+
+static void post_module_completion(int64_t port, int64_t request_id, ETStatus* status, ETModule* module) {
+    std::vector<int64_t> handles;
+    if (module) handles.push_back(static_cast<int64_t>(reinterpret_cast<intptr_t>(module)));
+    if (!post_completion(port, request_id, status, handles)) et_module_free(module);
+}
+
+ET_API ETStatus* et_module_load_async_port(
+    const uint8_t* data,
+    size_t data_size,
+    const ETLoadOptions* options,
+    int64_t port,
+    int64_t request_id
+) {
+    if (!g_dart_post_cobject.load()) {
+        return create_status(ET_INVALID_STATE, "et_dart_init() has not been called", __func__);
+    }
+    if (!data || data_size == 0) {
+        return create_status(ET_INVALID_ARGUMENT, "invalid model data", __func__);
+    }
+    ET_LOG("et_module_load_async_port: spawning thread, size=%zu bytes, port=%lld",
+           data_size, static_cast<long long>(port));
+
+    ET_TRY {
+        std::vector<uint8_t> data_copy(data, data + data_size);
+        auto options_copy = copy_load_options(options);
+        if (options_copy) options_copy->progress_request_id = request_id;
+        std::thread([data_copy = std::move(data_copy), options_copy = std::move(options_copy), port, request_id]() {
+            ETModule* module = nullptr;
+            ETStatus* status = et_module_load_with_options(data_copy.data(), data_copy.size(), options_copy.get(), &module);
+            post_module_completion(port, request_id, status, status && status->code == ET_OK ? module : nullptr);
+        }).detach();
+    } ET_CATCH(const std::exception&, e) {
+        return create_status(ET_OUT_OF_MEMORY, e.what(), __func__);
+    }
+    return create_ok_status();
+}
+
+ET_API ETStatus* et_module_load_file_async_port(
+    const char* path,
+    const ETLoadOptions* options,
+    int64_t port,
+    int64_t request_id
+) {
+    if (!g_dart_post_cobject.load()) {
+        return create_status(ET_INVALID_STATE, "et_dart_init() has not been called", __func__);
+    }
+    if (!path) {
+        return create_status(ET_INVALID_ARGUMENT, "path is null", __func__);
+    }
+    ET_LOG("et_module_load_file_async_port: spawning thread, path=%s, port=%lld",
+           path, static_cast<long long>(port));
+
+    ET_TRY {
+        auto options_copy = copy_load_options(options);
+        if (options_copy) options_copy->progress_request_id = request_id;
+        std::thread([path_copy = std::string(path), options_copy = std::move(options_copy), port, request_id]() {
+            ETModule* module = nullptr;
+            ETStatus* status = et_module_load_file_with_options(path_copy.c_str(), options_copy.get(), &module);
+            post_module_completion(port, request_id, status, status && status->code == ET_OK ? module : nullptr);
+        }).detach();
+    } ET_CATCH(const std::exception&, e) {
+        return create_status(ET_OUT_OF_MEMORY, e.what(), __func__);
+    }
+    return create_ok_status();
+}
+
+ET_API ETStatus* et_module_forward_async_port(
+    ETModule* module,
+    ETTensor** inputs,
+    int32_t input_count,
+    int64_t port,
+    int64_t request_id
+) {
+    if (!g_dart_post_cobject.load()) {
+        return create_status(ET_INVALID_STATE, "et_dart_init() has not been called", __func__);
+    }
+    if (!module || !module->loaded) {
+        return create_status(ET_INVALID_STATE, "module not loaded", __func__);
+    }
+    if (input_count < 0 || (input_count > 0 && !inputs)) {
+        return create_status(ET_INVALID_ARGUMENT, "inputs is null", __func__);
+    }
+    ET_LOG("et_module_forward_async_port: spawning thread with %d inputs, port=%lld",
+           input_count, static_cast<long long>(port));
+
+    ET_TRY {
+        std::vector<ETTensor*> input_copy(inputs, inputs + input_count);
+        std::thread([module, input_copy = std::move(input_copy), port, request_id]() mutable {
+            ETTensor** outputs = nullptr;
+            int32_t output_count = 0;
+            ETStatus* status = et_module_forward(
+                module, input_copy.data(), static_cast<int32_t>(input_copy.size()), &outputs, &output_count);
+
+            std::vector<int64_t> handles;
+            bool ok = status && status->code == ET_OK;
+            if (ok) {
+                for (int32_t i = 0; i < output_count; i++) {
+                    handles.push_back(static_cast<int64_t>(reinterpret_cast<intptr_t>(outputs[i])));
+                }
+            }
+            if (post_completion(port, request_id, status, handles) || !ok) {
+                et_tensor_array_release(outputs);  // Receiver owns the tensors
+            } else {
+                et_tensor_array_free(outputs, output_count);
+            }
+        }).detach();
+    } ET_CATCH(const std::exception&, e) {
+        return create_status(ET_OUT_OF_MEMORY, e.what(), __func__);
+    }
+    return create_ok_status();
+}
+
 /* ============================================================================
  * Backend Query Functions
  * ============================================================================ */
@@ -748,6 +3819,10 @@ ET_API void et_module_forward_async(
     #define ET_BUILD_QNN 0
 #endif
 
+#ifndef ET_BUILD_OPTIMIZED_KERNELS
+    #define ET_BUILD_OPTIMIZED_KERNELS 0
+#endif
+
 ET_API int32_t et_backend_available(ETBackend backend) {
     switch (backend) {
         case ET_BACKEND_XNNPACK: return ET_BUILD_XNNPACK;
@@ -756,6 +3831,7 @@ ET_API int32_t et_backend_available(ETBackend backend) {
         case ET_BACKEND_METAL: return ET_BUILD_METAL;
         case ET_BACKEND_VULKAN: return ET_BUILD_VULKAN;
         case ET_BACKEND_QNN: return ET_BUILD_QNN;
+        case ET_BACKEND_PORTABLE: return 1;
         default: return 0;
     }
 }
@@ -787,6 +3863,368 @@ ET_API int32_t et_backend_list(ETBackend* out, int32_t max_count) {
     return count;
 }
 
+ET_API ETStatus* et_backend_probe(ETBackend backend, ETBackendProbe* out) {
+    if (!out) {
+        return create_status(ET_INVALID_ARGUMENT, "out pointer is null", __func__);
+    }
+    if (!is_valid_backend(backend)) {
+        return create_status(ET_INVALID_ARGUMENT, "Unknown backend", __func__);
+    }
+
+    const BackendProbeResult& result = probe_backend(backend);
+    out->backend = backend;
+    out->compiled = et_backend_available(backend);
+    out->registered = result.registered ? 1 : 0;
+    out->available = result.available ? 1 : 0;
+    out->init_ms = result.init_ms;
+    return create_ok_status();
+}
+
+ET_API int32_t et_backend_probe_all(ETBackendProbe* out, int32_t max_count) {
+    if (!out || max_count <= 0) return 0;
+
+    int32_t count = 0;
+    for (int i = 0; i < kBackendCount && count < max_count; i++) {
+        ETBackend backend = static_cast<ETBackend>(i);
+        if (!et_backend_available(backend)) continue;
+        ETStatus* status = et_backend_probe(backend, &out[count]);
+        if (status && status->code == ET_OK) count++;
+        et_status_free(status);
+    }
+    return count;
+}
+
+ET_API const char* et_kernel_library(void) {
+    return ET_BUILD_OPTIMIZED_KERNELS ? "optimized" : "portable";
+}
+
+/* ============================================================================
+ * ISA Level Query Functions
+ * ============================================================================ */
+
+#if defined(__x86_64__) || defined(_M_X64)
+static void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; i++) regs[i] = static_cast<uint32_t>(r[i]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// XCR0: which register states the OS saves on context switch
+static uint64_t read_xcr0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+static ETIsaLevel detect_cpu_isa_level() {
+    uint32_t r[4];
+    cpuid(0, 0, r);
+    const uint32_t max_leaf = r[0];
+    cpuid(0x80000000, 0, r);
+    const uint32_t max_ext_leaf = r[0];
+
+    uint32_t ecx1 = 0, ebx7 = 0, ecx_ext1 = 0;
+    if (max_leaf >= 1) { cpuid(1, 0, r); ecx1 = r[2]; }
+    if (max_leaf >= 7) { cpuid(7, 0, r); ebx7 = r[1]; }
+    if (max_ext_leaf >= 0x80000001) { cpuid(0x80000001, 0, r); ecx_ext1 = r[2]; }
+
+    auto has = [](uint32_t reg, int bit) { return (reg >> bit) & 1u; };
+
+    // v2: CMPXCHG16B, LAHF-SAHF, POPCNT, SSE3, SSE4.1, SSE4.2, SSSE3
+    const bool v2 = has(ecx1, 0) && has(ecx1, 9) && has(ecx1, 13) &&
+                    has(ecx1, 19) && has(ecx1, 20) && has(ecx1, 23) &&
+                    has(ecx_ext1, 0);
+    if (!v2) return ET_ISA_LEVEL_X86_64_V1;
+
+    // v3: AVX, AVX2, BMI1, BMI2, F16C, FMA, LZCNT, MOVBE, OSXSAVE + YMM state
+    const bool osxsave = has(ecx1, 27);
+    const uint64_t xcr0 = osxsave ? read_xcr0() : 0;
+    const bool v3 = osxsave && (xcr0 & 0x6) == 0x6 &&
+                    has(ecx1, 12) && has(ecx1, 22) && has(ecx1, 28) &&
+                    has(ecx1, 29) && has(ecx_ext1, 5) &&
+                    has(ebx7, 3) && has(ebx7, 5) && has(ebx7, 8);
+    if (!v3) return ET_ISA_LEVEL_X86_64_V2;
+
+    // v4: AVX512F, AVX512BW, AVX512CD, AVX512DQ, AVX512VL + opmask/ZMM state
+    const bool v4 = (xcr0 & 0xE6) == 0xE6 &&
+                    has(ebx7, 16) && has(ebx7, 17) && has(ebx7, 28) &&
+                    has(ebx7, 30) && has(ebx7, 31);
+    return v4 ? ET_ISA_LEVEL_X86_64_V4 : ET_ISA_LEVEL_X86_64_V3;
+}
+#endif
+
+ET_API ETIsaLevel et_isa_level_built(void) {
+#if defined(__x86_64__) || defined(_M_X64)
+    #if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512CD__) && \
+        defined(__AVX512DQ__) && defined(__AVX512VL__)
+        return ET_ISA_LEVEL_X86_64_V4;
+    #elif defined(__AVX2__) && defined(__FMA__)
+        return ET_ISA_LEVEL_X86_64_V3;
+    #elif defined(__SSE4_2__)
+        return ET_ISA_LEVEL_X86_64_V2;
+    #else
+        return ET_ISA_LEVEL_X86_64_V1;
+    #endif
+#else
+    return ET_ISA_LEVEL_NONE;
+#endif
+}
+
+ET_API ETIsaLevel et_isa_level_cpu(void) {
+#if defined(__x86_64__) || defined(_M_X64)
+    static const ETIsaLevel level = detect_cpu_isa_level();
+    return level;
+#else
+    return ET_ISA_LEVEL_NONE;
+#endif
+}
+
+/* ============================================================================
+ * Custom Kernel Registration
+ * ============================================================================ */
+
+// ExecuTorch's registry stores plain function pointers and borrows the name
+// and key strings, so every custom kernel gets a fixed slot: static storage
+// for its strings and C callback, and its own trampoline instantiation.
+static constexpr int kMaxCustomKernels = 64;
+
+struct CustomKernel {
+    std::string op_name;
+    std::string kernel_key;
+    ETKernelFn fn;
+    void* user_data;
+};
+
+static CustomKernel g_custom_kernels[kMaxCustomKernels];
+static int g_custom_kernel_count = 0;
+static std::mutex g_custom_kernel_mutex;
+
+static void run_custom_kernel(int slot, KernelRuntimeContext& context, Span<EValue*> stack) {
+    const CustomKernel& kernel = g_custom_kernels[slot];
+
+    constexpr size_t kInlineArgs = 16;
+    ETKernelArg inline_args[kInlineArgs];
+    std::vector<ETKernelArg> heap_args;
+    ETKernelArg* args = inline_args;
+    if (stack.size() > kInlineArgs) {
+        heap_args.resize(stack.size());
+        args = heap_args.data();
+    }
+
+    for (size_t i = 0; i < stack.size(); i++) {
+        ETKernelArg& arg = args[i];
+        arg = ETKernelArg{};
+        const EValue& value = *stack[i];
+
+        if (value.isTensor()) {
+            const auto& tensor = value.toTensor();
+            arg.type = ET_KERNEL_ARG_TENSOR;
+            arg.dtype = from_scalar_type(tensor.scalar_type());
+            arg.rank = static_cast<int32_t>(tensor.dim());
+            arg.shape = tensor.sizes().data();
+            arg.data = tensor.mutable_data_ptr();
+            arg.nbytes = tensor.nbytes();
+        } else if (value.isInt()) {
+            arg.type = ET_KERNEL_ARG_INT;
+            arg.int_value = value.toInt();
+        } else if (value.isDouble()) {
+            arg.type = ET_KERNEL_ARG_DOUBLE;
+            arg.double_value = value.toDouble();
+        } else if (value.isBool()) {
+            arg.type = ET_KERNEL_ARG_BOOL;
+            arg.int_value = value.toBool() ? 1 : 0;
+        } else if (value.isNone()) {
+            arg.type = ET_KERNEL_ARG_NONE;
+        } else {
+            arg.type = ET_KERNEL_ARG_OTHER;
+        }
+    }
+
+    int32_t result = kernel.fn(args, static_cast<int32_t>(stack.size()), kernel.user_data);
+    if (result != 0) {
+        ET_LOG("custom kernel %s [%s] failed with %d",
+               kernel.op_name.c_str(), kernel.kernel_key.c_str(), result);
+        context.fail(Error::Internal);
+    }
+}
+
+template <int Slot>
+static void custom_kernel_trampoline(KernelRuntimeContext& context, Span<EValue*> stack) {
+    run_custom_kernel(Slot, context, stack);
+}
+
+template <int... Slots>
+static constexpr std::array<OpFunction, sizeof...(Slots)> make_custom_kernel_trampolines(
+    std::integer_sequence<int, Slots...>
+) {
+    return {{&custom_kernel_trampoline<Slots>...}};
+}
+
+static constexpr std::array<OpFunction, kMaxCustomKernels> g_custom_kernel_trampolines =
+    make_custom_kernel_trampolines(std::make_integer_sequence<int, kMaxCustomKernels>{});
+
+/**
+ * Parsed kernel key: the "v1/..." registry string the runtime builds for a
+ * call site with this signature (ScalarType numbers), plus its TensorMeta
+ * list.
+ */
+struct ParsedKernelKey {
+    std::string key;
+    std::vector<std::vector<executorch::aten::DimOrderType>> dim_orders;
+    std::vector<executorch::aten::ScalarType> dtypes;
+    std::vector<TensorMeta> metas;
+};
+
+// Signature dtype names, as the ETDType enumerators
+static constexpr std::pair<const char*, ETDType> kKernelDtypeNames[] = {
+    {"float32", ET_DTYPE_FLOAT32}, {"float64", ET_DTYPE_FLOAT64},
+    {"int64", ET_DTYPE_INT64},     {"int32", ET_DTYPE_INT32},
+    {"int16", ET_DTYPE_INT16},     {"int8", ET_DTYPE_INT8},
+    {"uint8", ET_DTYPE_UINT8},     {"bool", ET_DTYPE_BOOL},
+};
+
+static bool parse_kernel_key(const char* signature, ParsedKernelKey& out) {
+    std::string body(signature);
+    if (body.empty()) return false;
+
+    size_t pos = 0;
+    while (true) {
+        size_t end = body.find('|', pos);
+        std::string entry = body.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+
+        size_t semi = entry.find(';');
+        if (semi == std::string::npos || semi == 0) return false;
+
+        std::string dtype_name = entry.substr(0, semi);
+        const ETDType* dtype = nullptr;
+        for (const auto& named : kKernelDtypeNames) {
+            if (dtype_name == named.first) dtype = &named.second;
+        }
+        if (!dtype) return false;
+
+        char* parse_end = nullptr;
+
+        std::vector<executorch::aten::DimOrderType> dim_order;
+        size_t dim_pos = semi + 1;
+        while (dim_pos < entry.size()) {
+            long dim = strtol(entry.c_str() + dim_pos, &parse_end, 10);
+            size_t parsed = static_cast<size_t>(parse_end - entry.c_str());
+            if (parsed == dim_pos || dim < 0 || dim > 15) return false;
+            dim_order.push_back(static_cast<executorch::aten::DimOrderType>(dim));
+            if (parsed == entry.size()) break;
+            if (entry[parsed] != ',') return false;
+            dim_pos = parsed + 1;
+            if (dim_pos == entry.size()) return false;  // trailing comma
+        }
+
+        out.dtypes.push_back(to_scalar_type(*dtype));
+        out.dim_orders.push_back(std::move(dim_order));
+
+        if (end == std::string::npos) break;
+        pos = end + 1;
+    }
+
+    // Rebuild in the exact format the runtime generates from TensorMeta
+    out.key = "v1/";
+    for (size_t i = 0; i < out.dtypes.size(); i++) {
+        if (i > 0) out.key += '|';
+        out.key += std::to_string(static_cast<int>(out.dtypes[i]));
+        out.key += ';';
+        for (size_t d = 0; d < out.dim_orders[i].size(); d++) {
+            if (d > 0) out.key += ',';
+            out.key += std::to_string(static_cast<int>(out.dim_orders[i][d]));
+        }
+    }
+    if (out.key.size() >= static_cast<size_t>(KernelKey::MAX_SIZE)) return false;
+
+    // dim_orders is complete, so the spans below stay valid
+    for (size_t i = 0; i < out.dtypes.size(); i++) {
+        out.metas.emplace_back(
+            out.dtypes[i],
+            Span<executorch::aten::DimOrderType>(out.dim_orders[i].data(), out.dim_orders[i].size()));
+    }
+    return true;
+}
+
+ET_API ETStatus* et_register_kernel(
+    const char* op_name,
+    const char* dtype_signature,
+    ETKernelFn fn,
+    void* user_data
+) {
+    if (!op_name || !*op_name || !dtype_signature || !fn) {
+        return create_status(ET_INVALID_ARGUMENT, "Invalid argument: null or empty parameter", __func__);
+    }
+
+    ParsedKernelKey parsed;
+    if (!parse_kernel_key(dtype_signature, parsed)) {
+        return create_status(ET_INVALID_ARGUMENT,
+            "Invalid dtype signature: expected \"dtype;dim_order|...\", e.g. \"float32;0,1,2,3|float32;0,1,2,3\"",
+            __func__);
+    }
+
+    std::lock_guard<std::mutex> lock(g_custom_kernel_mutex);
+
+    if (g_custom_kernel_count >= kMaxCustomKernels) {
+        return create_status(ET_UNSUPPORTED, "Too many custom kernels (max 64)", __func__);
+    }
+
+    int slot = g_custom_kernel_count;
+    CustomKernel& kernel = g_custom_kernels[slot];
+    kernel.op_name = op_name;
+    kernel.kernel_key = std::move(parsed.key);
+    kernel.fn = fn;
+    kernel.user_data = user_data;
+
+    Error error = register_kernel(Kernel(
+        kernel.op_name.c_str(),
+        KernelKey(kernel.kernel_key.c_str()),
+        g_custom_kernel_trampolines[slot]));
+
+    if (error != Error::Ok) {
+        char msg[256];
+        snprintf(msg, sizeof(msg), "Failed to register %s [%s]: %s (error %d)",
+                 op_name, kernel.kernel_key.c_str(),
+                 error == Error::RegistrationAlreadyRegistered ? "already registered" : "registry error",
+                 static_cast<int>(error));
+        kernel = CustomKernel{};
+        return create_status(
+            error == Error::RegistrationAlreadyRegistered ? ET_INVALID_STATE : ET_INTERNAL,
+            msg, __func__);
+    }
+
+    g_custom_kernel_count++;
+    ET_LOG("et_register_kernel: %s [%s] -> slot %d", op_name, kernel.kernel_key.c_str(), slot);
+    return create_ok_status();
+}
+
+ET_API ETKernelSource et_kernel_resolve(const char* op_name, const char* dtype_signature) {
+    if (!op_name || !*op_name) return ET_KERNEL_SOURCE_MISSING;
+
+    ParsedKernelKey parsed;
+    if (dtype_signature && *dtype_signature && !parse_kernel_key(dtype_signature, parsed)) {
+        return ET_KERNEL_SOURCE_MISSING;
+    }
+
+    Result<OpFunction> op = get_op_function_from_registry(
+        op_name, Span<const TensorMeta>(parsed.metas.data(), parsed.metas.size()));
+    if (!op.ok()) return ET_KERNEL_SOURCE_MISSING;
+
+    std::lock_guard<std::mutex> lock(g_custom_kernel_mutex);
+    for (int i = 0; i < g_custom_kernel_count; i++) {
+        if (*op == g_custom_kernel_trampolines[i]) return ET_KERNEL_SOURCE_CUSTOM;
+    }
+    return ET_KERNEL_SOURCE_BUILTIN;
+}
+
 /* ============================================================================
  * Utility Functions
  * ============================================================================ */
@@ -26,7 +26,10 @@ extern "C" {
  * Export Macros
  * ============================================================================ */
 
-#if defined(_WIN32) || defined(_WIN64)
+#if defined(EXECUTORCH_FFI_STATIC)
+    // Static library (executorch_ffi_static): linked into the host directly
+    #define ET_API
+#elif defined(_WIN32) || defined(_WIN64)
     #ifdef EXECUTORCH_FFI_EXPORTS
         #define ET_API __declspec(dllexport)
     #else
@@ -75,6 +78,9 @@ typedef enum {
  * When code is ET_OK, message and location are NULL.
  * When code is non-zero, message contains error description.
  * Caller must free with et_status_free().
+ *
+ * Memory: ET_OK statuses are a shared static instance (no allocation) that
+ * et_status_free() ignores - do not modify a returned status.
  */
 typedef struct ETStatus {
     int32_t code;           /**< Error code (0 = success) */
@@ -114,7 +120,8 @@ typedef struct ETTensor ETTensor;
 /**
  * Create a tensor from data.
  *
- * @param data      Pointer to tensor data (copied)
+ * @param data      Pointer to tensor data (copied), or NULL for a
+ *                  zero-filled tensor to write via et_tensor_mutable_data()
  * @param data_size Size of data in bytes
  * @param shape     Array of dimension sizes
  * @param rank      Number of dimensions
@@ -162,12 +169,50 @@ ET_API size_t et_tensor_data_size(const ETTensor* tensor);
  */
 ET_API const void* et_tensor_data(const ETTensor* tensor);
 
+/**
+ * Get writable tensor data pointer, e.g. to fill a shared-memory tensor
+ * in place.
+ *
+ * @return Pointer to internal data (do not free, valid until tensor freed)
+ */
+ET_API void* et_tensor_mutable_data(ETTensor* tensor);
+
+/**
+ * Get tensor element count (product of the shape).
+ */
+ET_API size_t et_tensor_element_count(const ETTensor* tensor);
+
 /**
  * Free tensor handle.
  * Safe to call with NULL.
  */
 ET_API void et_tensor_free(ETTensor* tensor);
 
+/**
+ * Native finalizer that frees a tensor, for viewing its data from Dart
+ * without a copy:
+ *
+ *   final list = et_tensor_data(t).cast<Float>()
+ *       .asTypedList(et_tensor_element_count(t),
+ *                    finalizer: addressOf(et_tensor_finalizer).cast(),
+ *                    token: t.cast());
+ *
+ * The tensor is freed when the typed list is garbage-collected; do not call
+ * et_tensor_free() on it afterwards, and read shape / dtype before the list
+ * is the only reference. Tensor data is allocated with operator new
+ * alignment, so any typed list view is valid. Safe to call with NULL.
+ *
+ * @param tensor  ETTensor* (the finalizer token)
+ */
+ET_API void et_tensor_finalizer(void* tensor);
+
+/**
+ * Dart_HandleFinalizer variant of et_tensor_finalizer(), for
+ * Dart_NewExternalTypedDataWithFinalizer() and external typed data
+ * posted with Dart_PostCObject (the tensor is the peer).
+ */
+ET_API void et_tensor_external_finalizer(void* isolate_callback_data, void* tensor);
+
 /* ============================================================================
  * Module (Model) API
  * ============================================================================ */
@@ -216,6 +261,37 @@ ET_API int32_t et_module_input_count(const ETModule* module);
  */
 ET_API int32_t et_module_output_count(const ETModule* module);
 
+/** Maximum tensor rank in an ETTensorSpec (ExecuTorch's dimension limit). */
+#define ET_MAX_RANK 16
+
+/**
+ * Shape and type of a forward input or output, from the program's metadata.
+ */
+typedef struct {
+    ETDType dtype;
+    int32_t rank;
+    int64_t shape[ET_MAX_RANK];  // First `rank` entries; upper bounds for dynamic dims
+    size_t nbytes;               // Byte size at that shape
+    int32_t memory_planned;      // 1 if the runtime owns its memory (not bindable)
+} ETTensorSpec;
+
+/**
+ * Get the spec of a forward input.
+ *
+ * @param module  Module handle
+ * @param index   Input index
+ * @param out     Output spec
+ * @return Status (caller must free); ET_UNSUPPORTED for non-tensor inputs
+ *
+ * Thread Safety: Function is thread-safe
+ */
+ET_API ETStatus* et_module_input_spec(const ETModule* module, int32_t index, ETTensorSpec* out);
+
+/**
+ * Get the spec of a forward output. See et_module_input_spec().
+ */
+ET_API ETStatus* et_module_output_spec(const ETModule* module, int32_t index, ETTensorSpec* out);
+
 /**
  * Run forward pass (inference).
  *
@@ -237,6 +313,31 @@ ET_API ETStatus* et_module_forward(
     int32_t* output_count
 );
 
+/**
+ * Run a method other than forward. The method must have been initialized
+ * at load time (et_load_options_set_methods()); "forward" runs forward.
+ * Outputs bound with et_module_bind_output() apply to forward only.
+ *
+ * @param module       Module handle
+ * @param method_name  Method name
+ * @param inputs       Array of input tensor handles
+ * @param input_count  Number of inputs
+ * @param outputs      Output array of tensor handles (caller must free array and tensors)
+ * @param output_count Output number of outputs
+ * @return Status (caller must free); ET_INVALID_ARGUMENT if the method
+ *         was not initialized
+ *
+ * Thread Safety: As et_module_forward(); calls on one module are serialized
+ */
+ET_API ETStatus* et_module_execute(
+    ETModule* module,
+    const char* method_name,
+    ETTensor** inputs,
+    int32_t input_count,
+    ETTensor*** outputs,
+    int32_t* output_count
+);
+
 /**
  * Free module handle.
  * Safe to call with NULL.
@@ -327,7 +428,8 @@ typedef enum {
     ET_BACKEND_MPS = 2,  // Deprecated: no longer built, kept for ABI stability
     ET_BACKEND_VULKAN = 3,
     ET_BACKEND_QNN = 4,
-    ET_BACKEND_METAL = 5  // macOS-desktop GPU (AOTI); replaces MPS
+    ET_BACKEND_METAL = 5,  // macOS-desktop GPU (AOTI); replaces MPS
+    ET_BACKEND_PORTABLE = 6  // No delegate: CPU kernel library only
 } ETBackend;
 
 /**
@@ -339,7 +441,8 @@ typedef enum {
 ET_API int32_t et_backend_available(ETBackend backend);
 
 /**
- * Get list of available backends.
+ * Get list of available delegate backends.
+ * ET_BACKEND_PORTABLE is always available and not listed.
  *
  * @param out        Output array of backends (caller allocates, max 16 elements)
  * @param max_count  Maximum number of backends to return
@@ -347,6 +450,1091 @@ ET_API int32_t et_backend_available(ETBackend backend);
  */
 ET_API int32_t et_backend_list(ETBackend* out, int32_t max_count);
 
+/**
+ * Runtime probe result for one backend.
+ *
+ * These are health flags only. ExecuTorch's backend interface exposes a
+ * usability check and nothing else, so no device capabilities (supported
+ * dtypes, device name, memory) are reported.
+ */
+typedef struct {
+    ETBackend backend;
+    int32_t compiled;     // Built in (same as et_backend_available)
+    int32_t registered;   // Registered with the ExecuTorch runtime
+    int32_t available;    // Runtime check passed: device / driver usable
+    double init_ms;       // Time the runtime check took (ms)
+} ETBackendProbe;
+
+/**
+ * Probe whether a backend actually works on this device.
+ *
+ * Runs the backend's runtime availability check - which initializes the
+ * device / driver for GPU and NPU backends, e.g. a Vulkan instance - once
+ * per process and caches the result, so repeated calls are cheap. Use it
+ * to avoid loading a model exported for a backend that would fail here.
+ *
+ * @param backend  Backend to probe
+ * @param out      Probe result
+ * @return Status (caller must free)
+ *
+ * Thread Safety: Function is thread-safe
+ */
+ET_API ETStatus* et_backend_probe(ETBackend backend, ETBackendProbe* out);
+
+/**
+ * Probe every built-in backend (including ET_BACKEND_PORTABLE).
+ *
+ * @param out        Output array (caller allocates)
+ * @param max_count  Maximum number of results
+ * @return Number of results written
+ */
+ET_API int32_t et_backend_probe_all(ETBackendProbe* out, int32_t max_count);
+
+/**
+ * Get the CPU kernel library used for non-delegated operators.
+ *
+ * @return "optimized" when built with ET_BUILD_OPTIMIZED_KERNELS
+ *         (optimized + quantized kernels, portable fallback), otherwise
+ *         "portable" (do not free)
+ */
+ET_API const char* et_kernel_library(void);
+
+/**
+ * x86-64 microarchitecture levels (psABI "x86-64-vN").
+ */
+typedef enum {
+    ET_ISA_LEVEL_NONE = 0,       // Not an x86-64 build / CPU
+    ET_ISA_LEVEL_X86_64_V1 = 1,  // Baseline x86-64 (SSE2)
+    ET_ISA_LEVEL_X86_64_V2 = 2,  // + SSE4.2, POPCNT, SSSE3
+    ET_ISA_LEVEL_X86_64_V3 = 3,  // + AVX2, FMA, BMI2, F16C
+    ET_ISA_LEVEL_X86_64_V4 = 4   // + AVX-512 F/BW/CD/DQ/VL
+} ETIsaLevel;
+
+/**
+ * Get the ISA level this library was compiled for (ET_X86_64_LEVEL).
+ *
+ * Derived from the compiler's target macros, so it reflects the flags the
+ * kernels were actually built with.
+ *
+ * @return ISA level, ET_ISA_LEVEL_NONE on non-x86-64 builds
+ */
+ET_API ETIsaLevel et_isa_level_built(void);
+
+/**
+ * Get the highest ISA level the running CPU and OS support.
+ *
+ * Checks CPUID feature bits and the OS-enabled register state (XGETBV),
+ * so AVX / AVX-512 disabled by the OS or hypervisor are not reported.
+ * Deployment can use it to verify the fast path is active: built == cpu.
+ *
+ * To choose which variant to load, run the check from the baseline (v1)
+ * build or from the loader itself: a v2/v3/v4 build may execute
+ * instructions the CPU lacks - in static initializers or compiler-generated
+ * code - and die with SIGILL before this function is ever called.
+ *
+ * @return ISA level, ET_ISA_LEVEL_NONE on non-x86-64 CPUs
+ */
+ET_API ETIsaLevel et_isa_level_cpu(void);
+
+/* ============================================================================
+ * Load Options API
+ * ============================================================================ */
+
+/**
+ * Opaque load options handle.
+ *
+ * Holds per-backend key/value options applied while a model's delegates are
+ * initialized, so each model can tune its delegates (e.g. XNNPACK
+ * "workspace_sharing_mode") without rebuilding. Keys and accepted values are
+ * defined by each backend.
+ */
+typedef struct ETLoadOptions ETLoadOptions;
+
+/**
+ * Create empty load options.
+ *
+ * @return Options handle (free with et_load_options_free), NULL on OOM
+ */
+ET_API ETLoadOptions* et_load_options_create(void);
+
+/**
+ * Free load options.
+ * Safe to call with NULL. Options may be freed right after loading.
+ */
+ET_API void et_load_options_free(ETLoadOptions* options);
+
+/**
+ * Set an integer backend option.
+ *
+ * Setting the same backend/key again replaces the previous value.
+ *
+ * @param options  Options handle
+ * @param backend  Backend the option is forwarded to
+ * @param key      Option key (max 63 characters)
+ * @param value    Option value
+ * @return Status (caller must free)
+ */
+ET_API ETStatus* et_load_options_set_backend_int(
+    ETLoadOptions* options,
+    ETBackend backend,
+    const char* key,
+    int32_t value
+);
+
+/**
+ * Set a boolean backend option (0 = false, non-zero = true).
+ * See et_load_options_set_backend_int().
+ */
+ET_API ETStatus* et_load_options_set_backend_bool(
+    ETLoadOptions* options,
+    ETBackend backend,
+    const char* key,
+    int32_t value
+);
+
+/**
+ * Set a string backend option (value max 255 characters).
+ * See et_load_options_set_backend_int().
+ */
+ET_API ETStatus* et_load_options_set_backend_string(
+    ETLoadOptions* options,
+    ETBackend backend,
+    const char* key,
+    const char* value
+);
+
+/**
+ * Calibrate the CPU thread count when loading.
+ *
+ * Before the model's delegates are initialized, runs forward with
+ * zero-filled inputs shaped from the method metadata for each candidate
+ * thread count (one warm-up run, then `iterations` timed runs) and keeps
+ * the count with the lowest median latency. With a cache path the result
+ * is stored per model hash and CPU model, and later loads of the same model
+ * on the same CPU reuse it without calibrating.
+ *
+ * The thread count is a process-wide setting, not a per-model one: the
+ * threadpool is shared by the whole process and delegates bind to it when
+ * initialized, so it can only change while no other module is loaded. With
+ * other modules loaded, tuning is skipped and the current thread count is
+ * kept - in practice only the first model loaded is tuned, and every later
+ * model runs with its thread count. et_module_thread_tuned() reports
+ * whether tuning applied to a load. Models whose inputs are not all
+ * tensors are not calibrated.
+ *
+ * @param options          Options handle
+ * @param candidates       Thread counts to try, NULL for 1, 2, 4, ... up to
+ *                         the number of logical cores
+ * @param candidate_count  Number of candidates (0 with NULL candidates)
+ * @param iterations       Timed runs per candidate (0 = 5)
+ * @param cache_path       Tuning cache file, NULL for no persistence
+ * @return Status (caller must free)
+ */
+ET_API ETStatus* et_load_options_set_thread_autotune(
+    ETLoadOptions* options,
+    const int32_t* candidates,
+    int32_t candidate_count,
+    int32_t iterations,
+    const char* cache_path
+);
+
+/**
+ * Place the model on a NUMA node (Linux only).
+ *
+ * The model buffer and the forward method's planned memory are allocated
+ * on the node, and loading and et_module_forward() run on the node's CPUs,
+ * so runtime and delegate allocations (e.g. packed weights) land there too.
+ * File loads read the program into node memory instead of mapping it.
+ *
+ * Weights are read-only, so an instance pool on a multi-socket server gets
+ * per-node weight replicas by loading one instance per node. Threadpool
+ * workers are shared by all modules; see et_numa_pin_threadpool().
+ *
+ * @param options  Options handle
+ * @param node     NUMA node, or -1 for default placement
+ * @return Status (caller must free), ET_UNSUPPORTED for node >= 0 off Linux
+ */
+ET_API ETStatus* et_load_options_set_numa_node(ETLoadOptions* options, int32_t node);
+
+/**
+ * Get the number of NUMA nodes.
+ *
+ * @return Node count, 0 if NUMA is not supported on this platform
+ */
+ET_API int32_t et_numa_node_count(void);
+
+/**
+ * Pin the CPU threadpool workers to a NUMA node's CPUs.
+ *
+ * The threadpool is process-wide, so this affects every module; use it
+ * when all latency-critical modules are placed on the same node.
+ *
+ * @param node  NUMA node, or -1 to restore the workers' original affinity
+ * @return Status (caller must free), ET_UNSUPPORTED off Linux or without
+ *         the threadpool extension
+ * Thread Safety: Do not call while another thread runs inference
+ */
+ET_API ETStatus* et_numa_pin_threadpool(int32_t node);
+
+/**
+ * Huge page backing modes.
+ */
+typedef enum {
+    ET_HUGE_PAGES_OFF = 0,          /**< Base pages (default) */
+    ET_HUGE_PAGES_TRANSPARENT = 1,  /**< Transparent huge pages (madvise) */
+    ET_HUGE_PAGES_EXPLICIT = 2      /**< hugetlbfs pages, transparent if the pool is empty */
+} ETHugePages;
+
+/**
+ * Back the model buffer and the forward method's planned memory with huge
+ * pages (Linux only), reducing TLB misses for large models.
+ *
+ * Transparent huge pages need /sys/kernel/mm/transparent_hugepage/enabled
+ * set to "madvise" or "always"; explicit pages need a reserved pool
+ * (vm.nr_hugepages). Buffers are rounded up to the huge page size (the PMD
+ * size for transparent pages). Huge pages are advisory: when they cannot be
+ * mapped, the buffers fall back to base pages instead of failing the load.
+ * File loads read the program into memory instead of mapping it. Use
+ * et_module_huge_page_fraction() to check what the kernel actually provided.
+ *
+ * @param options  Options handle
+ * @param mode     Backing mode
+ * @return Status (caller must free), ET_UNSUPPORTED for huge pages off Linux
+ */
+ET_API ETStatus* et_load_options_set_huge_pages(ETLoadOptions* options, ETHugePages mode);
+
+/**
+ * XNNPACK workspace sharing modes.
+ *
+ * The workspace is the scratch memory XNNPACK runtimes use for
+ * intermediate tensors. Sharing one workspace makes its size the maximum
+ * over the sharing delegates instead of their sum, at the cost of
+ * serializing their execution on the workspace's lock - so share only
+ * between modules that never run concurrently.
+ *
+ * XNNPACK does not report workspace sizes, so this library does not report
+ * the memory saved or the latency impact of a mode. Measure them per model:
+ * process RSS after loading, and et_compare with
+ * --b-option xnnpack.workspace_sharing_mode=N for latency.
+ */
+typedef enum {
+    ET_XNNPACK_WORKSPACE_DISABLED = 0,   // One workspace per delegate
+    ET_XNNPACK_WORKSPACE_PER_MODEL = 1,  // Delegates of one model share a workspace
+    ET_XNNPACK_WORKSPACE_GLOBAL = 2      // All delegates loaded in this mode share one
+} ETXnnpackWorkspaceSharing;
+
+/**
+ * Set the XNNPACK workspace sharing mode for models loaded with these
+ * options (XNNPACK "workspace_sharing_mode" backend option).
+ *
+ * Modules loaded with ET_XNNPACK_WORKSPACE_GLOBAL form one sharing group;
+ * XNNPACK has no finer-grained groups.
+ *
+ * @param options  Options handle
+ * @param mode     Sharing mode
+ * @return Status (caller must free)
+ */
+ET_API ETStatus* et_load_options_set_xnnpack_workspace_sharing(
+    ETLoadOptions* options,
+    ETXnnpackWorkspaceSharing mode
+);
+
+/**
+ * Set the process-wide default XNNPACK workspace sharing mode, used by
+ * every later load that does not set it in its load options.
+ *
+ * @param mode  Sharing mode
+ * @return Status (caller must free); ET_UNSUPPORTED without XNNPACK
+ */
+ET_API ETStatus* et_xnnpack_set_workspace_sharing(ETXnnpackWorkspaceSharing mode);
+
+/**
+ * Get the process-wide default XNNPACK workspace sharing mode.
+ *
+ * @param out  Output mode
+ * @return Status (caller must free); ET_UNSUPPORTED without XNNPACK
+ */
+ET_API ETStatus* et_xnnpack_get_workspace_sharing(ETXnnpackWorkspaceSharing* out);
+
+/**
+ * Load phases, reported in order by the progress callback.
+ */
+typedef enum {
+    ET_LOAD_PHASE_PROGRAM_PARSED = 0,        /**< Program header and methods parsed */
+    ET_LOAD_PHASE_METADATA = 1,              /**< Forward I/O specs available */
+    ET_LOAD_PHASE_DELEGATES_INITIALIZED = 2, /**< Forward method and its delegates initialized */
+    ET_LOAD_PHASE_READY = 3                  /**< Module can run inference */
+} ETLoadPhase;
+
+/**
+ * Load progress callback.
+ *
+ * Called synchronously on the loading thread as each phase completes.
+ * From ET_LOAD_PHASE_METADATA on, et_module_input_count(),
+ * et_module_output_count(), et_module_input_spec() and
+ * et_module_output_spec() may be called on `module` inside the callback,
+ * while delegate initialization - usually the slow part - is still ahead.
+ * No other function may be called on it before ET_LOAD_PHASE_READY.
+ *
+ * @param module      Module being loaded; only valid during the callback
+ *                    (the load may still fail and free it)
+ * @param phase       Completed phase
+ * @param elapsed_ms  Time since the load started
+ * @param user_data   Value passed to et_load_options_set_progress_callback()
+ */
+typedef void (*ETLoadProgressCallback)(
+    const ETModule* module,
+    ETLoadPhase phase,
+    double elapsed_ms,
+    void* user_data
+);
+
+/**
+ * Report load progress through a callback.
+ *
+ * Phases after a failure are not reported; the load's status reports the
+ * failure. et_module_load_preferred() reports the phases of every variant
+ * it tries, starting over at ET_LOAD_PHASE_PROGRAM_PARSED. Asynchronous
+ * loads call it from their worker thread. Use the callback to read I/O
+ * specs early; with a NativeCallable.listener the call is delivered after
+ * the callback returned, so only phase and elapsed_ms are meaningful there -
+ * from Dart, use et_load_options_set_progress_port() instead.
+ *
+ * @param options    Options handle
+ * @param callback   Progress callback, or NULL to disable
+ * @param user_data  Passed to every call
+ * @return Status (caller must free)
+ */
+ET_API ETStatus* et_load_options_set_progress_callback(
+    ETLoadOptions* options,
+    ETLoadProgressCallback callback,
+    void* user_data
+);
+
+/**
+ * Post load progress to a Dart native port (see the Dart Native Port API).
+ *
+ * The Dart counterpart of et_load_options_set_progress_callback(): a
+ * listener cannot use the module handle, which is only valid during the
+ * load, so each completed phase is posted with the I/O counts instead, as
+ * one Int64List message:
+ *
+ *   [request_id, phase, elapsed_us, input_count, output_count]
+ *
+ * - request_id:   the *_async_port load's request_id, 0 for other loads
+ * - phase:        ETLoadPhase
+ * - elapsed_us:   time since the load started (microseconds)
+ * - input_count / output_count: forward's I/O counts from
+ *                 ET_LOAD_PHASE_METADATA on, -1 before
+ *
+ * Use a port of its own: progress messages are not distinguishable from
+ * completions by shape. Requires et_dart_init(); without it nothing is posted.
+ *
+ * @param options  Options handle
+ * @param port     Dart native port, 0 to disable
+ * @return Status (caller must free)
+ */
+ET_API ETStatus* et_load_options_set_progress_port(ETLoadOptions* options, int64_t port);
+
+/**
+ * Initialize more methods than forward at load time, e.g. the encoder and
+ * decoder of a multi-method program, so et_module_execute() can run them.
+ *
+ * Delegate initialization is CPU-heavy and independent per method. With
+ * `parallel`, each method initializes on its own thread while forward
+ * initializes on the loading thread, so cold start approaches the slowest
+ * method instead of the sum; the delegates must support concurrent init
+ * (ExecuTorch's built-in ones do). Each method gets its own memory
+ * arenas; planned memory placement (NUMA / huge pages) applies to forward.
+ * et_module_method_init_time_ms() reports the per-method times.
+ *
+ * @param options   Options handle
+ * @param names     Method names ("forward" is always initialized), or NULL
+ *                  for every method in the program
+ * @param count     Number of names (0 with NULL names)
+ * @param parallel  Non-zero to initialize the methods concurrently
+ * @return Status (caller must free); loads fail with ET_INVALID_ARGUMENT if
+ *         a named method is not in the program
+ */
+ET_API ETStatus* et_load_options_set_methods(
+    ETLoadOptions* options,
+    const char* const* names,
+    int32_t count,
+    int32_t parallel
+);
+
+/**
+ * Load model from memory buffer with load options.
+ *
+ * Backend options are set through ExecuTorch's backend option interface
+ * for the duration of delegate initialization, then the previous values are
+ * restored, so they only affect this model. Loads that use backend options
+ * are serialized with each other.
+ *
+ * @param data       Model data (.pte format)
+ * @param data_size  Size of model data
+ * @param options    Load options (may be NULL)
+ * @param out        Output module handle
+ * @return Status (caller must free); ET_INVALID_ARGUMENT if a backend is
+ *         not built in or rejects an option
+ *
+ * Memory: data and options are not retained after function returns
+ * Thread Safety: Function is thread-safe
+ */
+ET_API ETStatus* et_module_load_with_options(
+    const uint8_t* data,
+    size_t data_size,
+    const ETLoadOptions* options,
+    ETModule** out
+);
+
+/**
+ * Load model from file path with load options.
+ * See et_module_load_with_options().
+ */
+ET_API ETStatus* et_module_load_file_with_options(
+    const char* path,
+    const ETLoadOptions* options,
+    ETModule** out
+);
+
+/**
+ * Load model from memory buffer with load options (async, threaded).
+ * See et_module_load_async() and et_module_load_with_options().
+ *
+ * Memory: data and options are copied before the function returns
+ */
+ET_API void et_module_load_async_with_options(
+    const uint8_t* data,
+    size_t data_size,
+    const ETLoadOptions* options,
+    ETModule** out,
+    ETCallback_1 callback
+);
+
+/**
+ * Load model from file path with load options (async, threaded).
+ * See et_module_load_file_async() and et_module_load_with_options().
+ *
+ * With et_load_options_set_progress_callback() the caller sees each load
+ * phase on the worker thread before `callback` reports the final status.
+ *
+ * Memory: path and options are copied before the function returns
+ */
+ET_API void et_module_load_file_async_with_options(
+    const char* path,
+    const ETLoadOptions* options,
+    ETModule** out,
+    ETCallback_1 callback
+);
+
+/**
+ * One exported variant of a model, for et_module_load_preferred().
+ */
+typedef struct {
+    ETBackend backend;      // Backend the variant was exported (delegated) for
+    const char* path;       // .pte file path, or NULL to use data/data_size
+    const uint8_t* data;    // .pte data (when path is NULL)
+    size_t data_size;
+} ETModelVariant;
+
+/**
+ * Load the first model variant whose backend initializes on this device.
+ *
+ * Variants are tried in the given order - most preferred first, fallback
+ * (typically an ET_BACKEND_XNNPACK or ET_BACKEND_PORTABLE export) last.
+ * A variant is skipped when its backend is not built in or fails its
+ * runtime probe (see et_backend_probe()), and the next one is tried when
+ * loading fails (e.g. delegate initialization error) or the loaded forward
+ * method does not delegate to the variant's backend. et_module_backend()
+ * and et_module_load_time_ms() report what was chosen and how long it took.
+ *
+ * Backend options in `options` for backends that are not built in are
+ * ignored, so options for every variant's backend can be given at once.
+ *
+ * @param variants       Model variants in preference order
+ * @param variant_count  Number of variants
+ * @param options        Load options for every attempt (may be NULL)
+ * @param out            Output module handle
+ * @return Status (caller must free); on failure the message lists why
+ *         each variant was rejected
+ *
+ * Memory: variant data and options are not retained after function returns
+ * Thread Safety: Function is thread-safe
+ */
+ET_API ETStatus* et_module_load_preferred(
+    const ETModelVariant* variants,
+    int32_t variant_count,
+    const ETLoadOptions* options,
+    ETModule** out
+);
+
+/**
+ * Get the backend of the variant et_module_load_preferred() selected.
+ * The variant's forward method was checked to delegate to it
+ * (ET_BACKEND_PORTABLE variants are not checked).
+ *
+ * @return ETBackend value, or -1 for modules loaded another way
+ */
+ET_API int32_t et_module_backend(const ETModule* module);
+
+/**
+ * Get how long loading the module took: program load plus forward method
+ * initialization, including delegate init (milliseconds).
+ *
+ * @return Load time in ms, 0 if module is NULL
+ */
+ET_API double et_module_load_time_ms(const ETModule* module);
+
+/**
+ * Get the number of initialized methods: forward plus those requested with
+ * et_load_options_set_methods().
+ *
+ * @return Method count, 0 if module is NULL or not loaded
+ */
+ET_API int32_t et_module_method_count(const ETModule* module);
+
+/**
+ * Get an initialized method's name; index 0 is "forward".
+ *
+ * @return Name (owned by the module), NULL if index is out of range
+ */
+ET_API const char* et_module_method_name(const ETModule* module, int32_t index);
+
+/**
+ * Get how long a method's initialization (including its delegates) took.
+ * With parallel init these overlap, so they add up to more than
+ * et_module_load_time_ms().
+ *
+ * @return Init time in ms, -1 if the method was not initialized
+ */
+ET_API double et_module_method_init_time_ms(const ETModule* module, const char* method_name);
+
+/**
+ * Get the CPU thread count the module's delegates were initialized with
+ * (the tuned count when et_load_options_set_thread_autotune() applied).
+ *
+ * @return Thread count, 0 if module is NULL or not loaded
+ */
+ET_API int32_t et_module_num_threads(const ETModule* module);
+
+/**
+ * Check whether et_load_options_set_thread_autotune() set the thread count
+ * for this load (calibrated or from the tuning cache).
+ *
+ * @return 1 if tuned, 0 if tuning was not requested, skipped because other
+ *         modules were loaded, or failed; 0 if module is NULL or not loaded
+ */
+ET_API int32_t et_module_thread_tuned(const ETModule* module);
+
+/**
+ * Get the NUMA node the module was placed on (et_load_options_set_numa_node()).
+ *
+ * @return Node, -1 if not placed or module is NULL / not loaded
+ */
+ET_API int32_t et_module_numa_node(const ETModule* module);
+
+/**
+ * Get the fraction of the module's model buffer and planned memory that is
+ * backed by huge pages (et_load_options_set_huge_pages()).
+ *
+ * Transparent huge pages are read from /proc/self/smaps and may be
+ * collapsed later by khugepaged, so the value can grow over time.
+ *
+ * @return Fraction in [0, 1], 0 if nothing is placed or module is NULL / not loaded
+ */
+ET_API double et_module_huge_page_fraction(const ETModule* module);
+
+/* ============================================================================
+ * Shape Bucket API
+ *
+ * Models exported with dynamic dimensions (sequence length, resolution) pay
+ * for resizing and re-planning - e.g. XNNPACK reshapes its runtime -
+ * whenever the input shape changes between calls. With buckets, the module
+ * keeps one forward instance per configured bucket shape, each bound to
+ * its own padded input buffers and warmed once at load, so every instance
+ * always runs the same shape:
+ *
+ * - et_module_forward() picks the smallest bucket the inputs fit, pads them
+ *   into that bucket's buffers, fills generated masks and runs the bucket's
+ *   instance. Inputs that are not bucketed are passed through.
+ * - Outputs configured for cropping are cut back to the actual sizes.
+ * - Inputs larger than every bucket fail with ET_INVALID_ARGUMENT.
+ *
+ * Each bucket has its own memory arenas; the delegates of all buckets
+ * initialize at load, concurrently with et_load_options_set_methods()
+ * parallel init.
+ *
+ * A bucket whose warm-up run fails - a shape the export cannot run - fails
+ * the load with ET_MODEL_LOAD_FAILED naming the bucket.
+ * ============================================================================ */
+
+/**
+ * How a bucketed input is prepared.
+ */
+typedef enum {
+    ET_BUCKET_PAD = 0,   /**< Caller's data, padded with pad_value */
+    ET_BUCKET_MASK = 1   /**< Generated: 1 inside the actual sizes, 0 in padding */
+} ETBucketRole;
+
+/**
+ * One bucketed dimension of an input or output.
+ */
+typedef struct {
+    int32_t index;       // Input / output index
+    int32_t dim;         // Dimension of that tensor
+    int32_t axis;        // Bucket axis giving its size
+    ETBucketRole role;   // Inputs only; all dims of one input share a role
+    double pad_value;    // Padding value (ET_BUCKET_PAD inputs)
+} ETBucketDim;
+
+/**
+ * Configure shape buckets for forward.
+ *
+ * A bucket is one size per axis: one axis for a sequence length, two for
+ * a resolution (height, width). The actual size of an axis is read from
+ * the ET_BUCKET_PAD inputs mapped to it, which must agree. ET_BUCKET_MASK
+ * inputs are written by the library; pass NULL for them to
+ * et_module_forward(). Output dims listed in `outputs` are cropped to the
+ * actual size of their axis.
+ *
+ * Example - token ids and attention mask of a [1, L] text model, logits
+ * [1, L, V] cropped, buckets L = 32, 64, 128:
+ *
+ *   int64_t sizes[] = {32, 64, 128};
+ *   ETBucketDim in[] = {{0, 1, 0, ET_BUCKET_PAD, 0}, {1, 1, 0, ET_BUCKET_MASK, 0}};
+ *   ETBucketDim out[] = {{0, 1, 0, ET_BUCKET_PAD, 0}};
+ *   et_load_options_set_buckets(options, sizes, 3, 1, in, 2, out, 1);
+ *
+ * @param options       Options handle
+ * @param sizes         bucket_count x axis_count sizes, row-major
+ * @param bucket_count  Number of buckets (0 disables bucketing)
+ * @param axis_count    Sizes per bucket
+ * @param inputs        Bucketed input dims
+ * @param input_count   Number of input dims
+ * @param outputs       Cropped output dims (role and pad_value unused)
+ * @param output_count  Number of output dims
+ * @return Status (caller must free); loads fail with ET_INVALID_ARGUMENT
+ *         if the dims do not match the model or a bucket exceeds a
+ *         dimension's upper bound
+ */
+ET_API ETStatus* et_load_options_set_buckets(
+    ETLoadOptions* options,
+    const int64_t* sizes,
+    int32_t bucket_count,
+    int32_t axis_count,
+    const ETBucketDim* inputs,
+    int32_t input_count,
+    const ETBucketDim* outputs,
+    int32_t output_count
+);
+
+/**
+ * Get the number of shape buckets of a module.
+ *
+ * @return Bucket count, 0 without buckets or if module is NULL / not loaded
+ */
+ET_API int32_t et_module_bucket_count(const ETModule* module);
+
+/**
+ * Get how many forward calls a bucket served, e.g. to tune the bucket list.
+ *
+ * @param module  Module handle
+ * @param bucket  Bucket index, in configuration order
+ * @return Call count, -1 if the bucket does not exist
+ *
+ * Thread Safety: Waits for an in-flight forward on the module
+ */
+ET_API int64_t et_module_bucket_hits(ETModule* module, int32_t bucket);
+
+/* ============================================================================
+ * Batch Split API
+ *
+ * A model exported for batch size B fails on larger batches. With batch
+ * splitting, et_module_forward() cuts an oversized batch into chunks of B
+ * rows, runs the chunks in parallel on several forward instances sharing
+ * the program, and writes each chunk's outputs into its rows of the
+ * returned tensors, so one call keeps every instance busy:
+ *
+ * - The split inputs are the ones listed at load, or by default input 0 and
+ *   every input whose dim 0 equals input 0's. B is dim 0 of the first split
+ *   input (its upper bound for dynamic shapes); other inputs go to every
+ *   chunk. List the inputs when a non-batch input can have dim 0 == B.
+ * - Full chunks read the caller's rows in place; the last chunk is padded
+ *   with zeros to B rows and its padding rows are dropped from the outputs.
+ * - Every output must have the chunk's batch as dim 0; they are
+ *   concatenated along it.
+ * - Batches of at most B rows run as before, on the module's own instance.
+ *
+ * Operators that use the process-wide CPU threadpool (XNNPACK) take turns
+ * on it, so chunks of delegated models overlap less than portable ones;
+ * a smaller threadpool (et_load_options_set_thread_autotune()) with more
+ * instances usually suits bulk work better.
+ *
+ * Each split call starts its worker threads (up to instances - 1; the
+ * calling thread is one of them) and joins them before returning. That
+ * costs tens of microseconds per call - negligible next to the chunks of
+ * bulk work, but batches only slightly over B pay it too.
+ * ============================================================================ */
+
+/**
+ * Split oversized forward batches across `instances` forward instances.
+ *
+ * The module's own instance is one of them; the others are created at
+ * load and initialize concurrently with et_load_options_set_methods()
+ * parallel init. Cannot be combined with shape buckets.
+ *
+ * @param options      Options handle
+ * @param instances    Chunks run at once (0 disables splitting, 1 runs the
+ *                     chunks one after another)
+ * @param inputs       Forward input indices to split along dim 0, NULL to
+ *                     split input 0 and the inputs sharing its dim 0
+ * @param input_count  Number of indices (0 with NULL inputs)
+ * @return Status (caller must free); loads fail with ET_INVALID_ARGUMENT
+ *         if a split input is out of range, has no batch dimension or a
+ *         different dim 0 than the first, or if shape buckets are set
+ */
+ET_API ETStatus* et_load_options_set_batch_split(
+    ETLoadOptions* options,
+    int32_t instances,
+    const int32_t* inputs,
+    int32_t input_count
+);
+
+/**
+ * Get the batch size oversized forward batches are split into.
+ *
+ * @return Rows per chunk, 0 without batch splitting or if module is NULL / not loaded
+ */
+ET_API int32_t et_module_batch_size(const ETModule* module);
+
+/* ============================================================================
+ * Shared-Memory Tensor API
+ *
+ * Tensors whose data lives in an anonymous shared-memory file (memfd on
+ * Linux / Android, an unlinked POSIX shm object on macOS / iOS), so an
+ * inference process and its client can hand tensors over without copying:
+ * send et_tensor_shared_fd() over a Unix socket (SCM_RIGHTS) and map it on
+ * the other side with et_tensor_import_shared().
+ *
+ * - Inputs: shared tensors are passed to the method in place. A method
+ *   input the exporter memory-planned is still copied once into the
+ *   module's arena; export with alloc_graph_input=False to avoid it.
+ * - Outputs: et_module_bind_output() makes the method write an output
+ *   straight into a shared tensor; et_module_forward() then returns a view
+ *   onto the same pages. Requires outputs that are not memory-planned
+ *   (export with alloc_graph_output=False).
+ *
+ * Not available on Windows (ET_UNSUPPORTED).
+ * ============================================================================ */
+
+/**
+ * Create a zero-filled tensor backed by shared memory.
+ *
+ * @param shape  Shape array
+ * @param rank   Number of dimensions
+ * @param dtype  Data type
+ * @param out    Output tensor handle
+ * @return Status (caller must free)
+ *
+ * Memory: the mapping is released when the tensor - and every output view
+ *         of a module it is bound to - is freed
+ */
+ET_API ETStatus* et_tensor_create_shared(
+    const int64_t* shape,
+    int32_t rank,
+    ETDType dtype,
+    ETTensor** out
+);
+
+/**
+ * Map shared memory exported by another process as a tensor.
+ *
+ * The fd must refer to at least the tensor's byte size (shape x dtype);
+ * writes through either side are visible to the other.
+ *
+ * @param fd     Shared-memory file descriptor (duplicated; caller keeps
+ *               ownership of fd and may close it right away)
+ * @param shape  Shape array
+ * @param rank   Number of dimensions
+ * @param dtype  Data type
+ * @param out    Output tensor handle
+ * @return Status (caller must free)
+ */
+ET_API ETStatus* et_tensor_import_shared(
+    int32_t fd,
+    const int64_t* shape,
+    int32_t rank,
+    ETDType dtype,
+    ETTensor** out
+);
+
+/**
+ * Get the file descriptor backing a shared-memory tensor, for exporting it.
+ *
+ * The fd is close-on-exec and owned by the tensor: do not close it, and
+ * dup() it to keep it past et_tensor_free().
+ *
+ * @return File descriptor, -1 if the tensor is not shared or NULL
+ */
+ET_API int32_t et_tensor_shared_fd(const ETTensor* tensor);
+
+/**
+ * Bind a forward output to a shared-memory tensor.
+ *
+ * Every later et_module_forward() writes output `index` into the tensor's
+ * pages and returns it as a view onto them (no copy). The module keeps the
+ * mapping alive; a binding lasts until the module is freed or the index
+ * is bound again.
+ *
+ * @param module  Module handle
+ * @param index   Output index
+ * @param tensor  Shared-memory tensor, at least the output's byte size
+ * @return Status (caller must free); ET_UNSUPPORTED if the output is
+ *         memory-planned or the module has shape buckets or batch splitting
+ *
+ * Thread Safety: Function is thread-safe (waits for a running forward)
+ */
+ET_API ETStatus* et_module_bind_output(ETModule* module, int32_t index, const ETTensor* tensor);
+
+/* ============================================================================
+ * Dart Native Port API
+ *
+ * Async variants that post completions straight to a Dart SendPort
+ * (ReceivePort.sendPort.nativePort) with Dart_PostCObject, instead of
+ * calling back through NativeCallable.listener. Each completion is one
+ * Int64List message:
+ *
+ *   [request_id, code, status, handle_0, handle_1, ...]
+ *
+ * - request_id: caller's value, to match completions to requests
+ * - code:       ETErrorCode
+ * - status:     ETStatus* with the error message when code != ET_OK
+ *               (receiver frees it with et_status_free), 0 on success
+ * - handles:    load: the ETModule*; forward: one ETTensor* per output.
+ *               The receiver owns them (et_module_free / et_tensor_free).
+ *
+ * If posting fails (port closed), everything in the message is freed.
+ * ============================================================================ */
+
+/**
+ * Mirror of Dart_CObject (dart_native_api.h), so this library does not need
+ * the Dart SDK headers. Only the typed-data member is used for posting.
+ */
+typedef enum {
+    ET_DART_COBJECT_NULL = 0,
+    ET_DART_COBJECT_BOOL = 1,
+    ET_DART_COBJECT_INT32 = 2,
+    ET_DART_COBJECT_INT64 = 3,
+    ET_DART_COBJECT_DOUBLE = 4,
+    ET_DART_COBJECT_STRING = 5,
+    ET_DART_COBJECT_ARRAY = 6,
+    ET_DART_COBJECT_TYPED_DATA = 7,
+    ET_DART_COBJECT_EXTERNAL_TYPED_DATA = 8,
+    ET_DART_COBJECT_SEND_PORT = 9,
+    ET_DART_COBJECT_CAPABILITY = 10,
+    ET_DART_COBJECT_NATIVE_POINTER = 11
+} ETDartCObjectType;
+
+/** Dart_TypedData_kInt64 */
+#define ET_DART_TYPED_DATA_INT64 8
+
+typedef struct ETDartCObject {
+    ETDartCObjectType type;
+    union {
+        uint8_t as_bool;
+        int32_t as_int32;
+        int64_t as_int64;
+        double as_double;
+        const char* as_string;
+        struct { int64_t id; int64_t origin_id; } as_send_port;
+        struct { int64_t id; } as_capability;
+        struct { intptr_t length; struct ETDartCObject** values; } as_array;
+        struct {
+            int32_t type;           /**< Dart_TypedData_Type */
+            intptr_t length;        /**< In elements, not bytes */
+            const uint8_t* values;
+        } as_typed_data;
+        struct {
+            int32_t type;
+            intptr_t length;
+            uint8_t* data;
+            void* peer;
+            void (*callback)(void* isolate_callback_data, void* peer);
+        } as_external_typed_data;
+        struct {
+            intptr_t ptr;
+            intptr_t size;
+            void (*callback)(void* isolate_callback_data, void* peer);
+        } as_native_pointer;
+    } value;
+} ETDartCObject;
+
+/**
+ * Dart_PostCObject signature. Copies the message; returns non-zero if it
+ * was posted.
+ */
+typedef uint8_t (*ETDartPostCObjectFn)(int64_t port_id, ETDartCObject* message);
+
+/**
+ * Set the function used to post to Dart ports.
+ *
+ * From Dart: et_dart_init(NativeApi.postCObject.cast()). Without a Dart VM,
+ * any function with the Dart_PostCObject signature can receive the messages.
+ *
+ * @param post_cobject  Dart_PostCObject, NULL to disable the port API
+ */
+ET_API void et_dart_init(ETDartPostCObjectFn post_cobject);
+
+/**
+ * Load model from memory buffer (async), posting the result to a port.
+ *
+ * @param data        Model data (.pte format, copied internally)
+ * @param data_size   Size of model data
+ * @param options     Load options (copied), NULL for defaults
+ * @param port        Dart native port
+ * @param request_id  Echoed as the first message element
+ * @return Status (caller must free); ET_INVALID_STATE before et_dart_init().
+ *         Nothing is posted when this returns an error.
+ */
+ET_API ETStatus* et_module_load_async_port(
+    const uint8_t* data,
+    size_t data_size,
+    const ETLoadOptions* options,
+    int64_t port,
+    int64_t request_id
+);
+
+/**
+ * Load model from file path (async), posting the result to a port.
+ * See et_module_load_async_port().
+ */
+ET_API ETStatus* et_module_load_file_async_port(
+    const char* path,
+    const ETLoadOptions* options,
+    int64_t port,
+    int64_t request_id
+);
+
+/**
+ * Run forward pass (async), posting the outputs to a port.
+ *
+ * Caller must keep the module and inputs alive until the message arrives.
+ *
+ * @param module       Module handle
+ * @param inputs       Array of input tensor handles (array is copied)
+ * @param input_count  Number of inputs
+ * @param port         Dart native port
+ * @param request_id   Echoed as the first message element
+ * @return Status (caller must free); nothing is posted on error
+ */
+ET_API ETStatus* et_module_forward_async_port(
+    ETModule* module,
+    ETTensor** inputs,
+    int32_t input_count,
+    int64_t port,
+    int64_t request_id
+);
+
+/* ============================================================================
+ * Custom Kernel API
+ * ============================================================================ */
+
+/**
+ * Kind of a kernel argument.
+ */
+typedef enum {
+    ET_KERNEL_ARG_NONE = 0,    // Optional argument not given
+    ET_KERNEL_ARG_TENSOR = 1,
+    ET_KERNEL_ARG_INT = 2,     // int_value
+    ET_KERNEL_ARG_DOUBLE = 3,  // double_value
+    ET_KERNEL_ARG_BOOL = 4,    // int_value (0 or 1)
+    ET_KERNEL_ARG_OTHER = 5    // Lists, strings, scalars: not exposed
+} ETKernelArgType;
+
+/**
+ * View of one operator argument, valid only during the kernel call.
+ *
+ * Arguments follow the operator schema order; for ".out" variants the
+ * output tensor is the last argument and is already allocated by the
+ * memory planner with the shape recorded at export time. Kernels write
+ * results into its data and must not resize it.
+ */
+typedef struct {
+    ETKernelArgType type;
+    /* ET_KERNEL_ARG_TENSOR */
+    ETDType dtype;
+    int32_t rank;
+    const int32_t* shape;
+    void* data;
+    size_t nbytes;
+    /* ET_KERNEL_ARG_INT / ET_KERNEL_ARG_BOOL */
+    int64_t int_value;
+    /* ET_KERNEL_ARG_DOUBLE */
+    double double_value;
+} ETKernelArg;
+
+/**
+ * Custom kernel function.
+ *
+ * @param args       Operator arguments
+ * @param arg_count  Number of arguments
+ * @param user_data  Pointer given at registration
+ * @return 0 on success; non-zero fails the running inference
+ */
+typedef int32_t (*ETKernelFn)(ETKernelArg* args, int32_t arg_count, void* user_data);
+
+/**
+ * Register a native kernel for an operator.
+ *
+ * The kernel is registered for one dtype / dim-order signature and takes
+ * priority over the built-in (portable or optimized) kernel for inputs that
+ * match it exactly; other inputs keep using the built-in kernel. The
+ * signature has one "dtype;dim_order" entry per tensor argument, in schema
+ * order, separated by '|'. dtype is the ETDType name (float32, float64,
+ * int64, int32, int16, int8, uint8, bool) and dim_order the comma-separated
+ * dimension order (0,1,...,rank-1 for contiguous tensors). Example for
+ * float32 4-D aten::relu.out (self, out): "float32;0,1,2,3|float32;0,1,2,3".
+ *
+ * Kernels are bound when a method is loaded, so register before loading
+ * the models that should use them. Registrations last for the lifetime of
+ * the process and cannot be replaced; at most 64 kernels can be registered.
+ *
+ * @param op_name          Operator name, e.g. "aten::relu.out"
+ * @param dtype_signature  Kernel key as described above
+ * @param fn               Kernel function
+ * @param user_data        Passed to every call (may be NULL)
+ * @return Status (caller must free with et_status_free)
+ *
+ * Thread Safety: Safe to call concurrently with other registrations, but
+ *                not while a model is being loaded.
+ */
+ET_API ETStatus* et_register_kernel(
+    const char* op_name,
+    const char* dtype_signature,
+    ETKernelFn fn,
+    void* user_data
+);
+
+/**
+ * Where an operator's kernel comes from.
+ */
+typedef enum {
+    ET_KERNEL_SOURCE_MISSING = 0,  // No kernel: loading a model using it fails
+    ET_KERNEL_SOURCE_BUILTIN = 1,  // Portable / optimized kernel library
+    ET_KERNEL_SOURCE_CUSTOM = 2    // Registered with et_register_kernel()
+} ETKernelSource;
+
+/**
+ * Resolve an operator the way method loading does.
+ *
+ * @param op_name          Operator name, e.g. "aten::relu.out"
+ * @param dtype_signature  Kernel key of the call site (see et_register_kernel),
+ *                         or NULL / "" to only check for a fallback kernel
+ * @return Which kernel a model calling the operator with these inputs gets
+ */
+ET_API ETKernelSource et_kernel_resolve(const char* op_name, const char* dtype_signature);
+
 /* ============================================================================
  * Utility Functions
  * ============================================================================ */
@@ -373,6 +1561,13 @@ ET_API const char* et_executorch_version(void);
  */
 ET_API void et_tensor_array_free(ETTensor** tensors, int32_t count);
 
+/**
+ * Free only the array returned by et_module_forward(), leaving the tensors
+ * alive - for outputs whose ownership moved to finalizers
+ * (et_tensor_finalizer()). Safe to call with NULL.
+ */
+ET_API void et_tensor_array_release(ETTensor** tensors);
+
 /**
  * Free a string allocated by this library.
  */
@@ -0,0 +1,552 @@
+/**
+ * @file executorch_ffi.hpp
+ * @brief Optional header-only C++17 wrapper for the ExecuTorch FFI C API
+ *
+ * Move-only RAII types for statuses, tensors, load options and modules on
+ * top of executorch_ffi.h. Every method is an inline call into the C API:
+ *
+ * - Results are returned as Result<T> (std::expected-style, stored inline);
+ *   only failures carry a heap-allocated C status with the error message.
+ * - Tensor data and shapes are exposed as borrowed Span views, valid for
+ *   the lifetime of the owning Tensor / TensorList.
+ * - Nothing throws, so the wrapper works with -fno-exceptions.
+ *
+ * Example:
+ *   auto module = executorch_ffi::Module::load_file("model.pte");
+ *   if (!module) { fprintf(stderr, "%s\n", module.error().message()); return; }
+ *   int64_t shape[] = {1, 3, 224, 224};
+ *   auto input = executorch_ffi::Tensor::create<float>(pixels, shape);
+ *   auto outputs = module->forward({*input});
+ *   executorch_ffi::Span<const float> logits = (*outputs)[0].data<float>();
+ */
+
+#ifndef EXECUTORCH_FFI_HPP
+#define EXECUTORCH_FFI_HPP
+
+#include "executorch_ffi.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace executorch_ffi {
+
+/* ============================================================================
+ * Span
+ * ============================================================================ */
+
+/**
+ * Borrowed view of contiguous elements (std::span subset for C++17).
+ */
+template <typename T>
+class Span {
+public:
+    constexpr Span() noexcept = default;
+    constexpr Span(T* data, size_t size) noexcept : data_(data), size_(size) {}
+
+    template <size_t N>
+    constexpr Span(T (&array)[N]) noexcept : data_(array), size_(N) {}
+
+    // Any contiguous container with data() / size() (std::vector, std::array, ...)
+    template <typename Container,
+              typename = std::enable_if_t<std::is_convertible_v<
+                  decltype(std::declval<Container&>().data()), T*>>>
+    constexpr Span(Container& container) noexcept
+        : data_(container.data()), size_(container.size()) {}
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr T* begin() const noexcept { return data_; }
+    constexpr T* end() const noexcept { return data_ + size_; }
+
+    constexpr T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/* ============================================================================
+ * Status and Result
+ * ============================================================================ */
+
+/**
+ * Owned ETStatus. Default-constructed and ET_OK statuses hold no allocation.
+ */
+class Status {
+public:
+    Status() noexcept = default;
+
+    // Takes ownership of a status returned by the C API. NULL only comes
+    // back when the status itself could not be allocated.
+    static Status adopt(ETStatus* status) noexcept {
+        Status result;
+        if (!status) {
+            result.code_ = ET_OUT_OF_MEMORY;
+        } else if (status->code != ET_OK) {
+            result.status_ = status;
+            result.code_ = status->code;
+        } else {
+            et_status_free(status);
+        }
+        return result;
+    }
+
+    ~Status() { et_status_free(status_); }
+
+    Status(const Status&) = delete;
+    Status& operator=(const Status&) = delete;
+
+    Status(Status&& other) noexcept
+        : status_(std::exchange(other.status_, nullptr)), code_(std::exchange(other.code_, ET_OK)) {}
+
+    Status& operator=(Status&& other) noexcept {
+        if (this != &other) {
+            et_status_free(status_);
+            status_ = std::exchange(other.status_, nullptr);
+            code_ = std::exchange(other.code_, ET_OK);
+        }
+        return *this;
+    }
+
+    bool ok() const noexcept { return code_ == ET_OK; }
+    explicit operator bool() const noexcept { return ok(); }
+
+    ETErrorCode code() const noexcept { return static_cast<ETErrorCode>(code_); }
+
+    /** Error message, "" when OK or unavailable. */
+    const char* message() const noexcept {
+        return status_ && status_->message ? status_->message : "";
+    }
+
+    /** Function that reported the error, "" when OK or unavailable. */
+    const char* location() const noexcept {
+        return status_ && status_->location ? status_->location : "";
+    }
+
+private:
+    ETStatus* status_ = nullptr;
+    int32_t code_ = ET_OK;
+};
+
+/**
+ * A value or an error Status (std::expected-style).
+ */
+template <typename T>
+class [[nodiscard]] Result {
+public:
+    Result(T value) noexcept : storage_(std::in_place_index<0>, std::move(value)) {}
+    Result(Status&& error) noexcept : storage_(std::in_place_index<1>, std::move(error)) {
+        assert(!std::get_if<1>(&storage_)->ok());
+    }
+
+    bool has_value() const noexcept { return storage_.index() == 0; }
+    explicit operator bool() const noexcept { return has_value(); }
+
+    T& value() & noexcept { assert(has_value()); return *std::get_if<0>(&storage_); }
+    const T& value() const& noexcept { assert(has_value()); return *std::get_if<0>(&storage_); }
+    T&& value() && noexcept { assert(has_value()); return std::move(*std::get_if<0>(&storage_)); }
+
+    T& operator*() & noexcept { return value(); }
+    const T& operator*() const& noexcept { return value(); }
+    T&& operator*() && noexcept { return std::move(*this).value(); }
+    T* operator->() noexcept { return &value(); }
+    const T* operator->() const noexcept { return &value(); }
+
+    /** The error. Only valid when !has_value(). */
+    const Status& error() const& noexcept { assert(!has_value()); return *std::get_if<1>(&storage_); }
+    Status&& error() && noexcept { assert(!has_value()); return std::move(*std::get_if<1>(&storage_)); }
+
+private:
+    std::variant<T, Status> storage_;
+};
+
+/* ============================================================================
+ * Tensors
+ * ============================================================================ */
+
+template <typename T> struct DTypeOf;
+template <> struct DTypeOf<float> { static constexpr ETDType value = ET_DTYPE_FLOAT32; };
+template <> struct DTypeOf<double> { static constexpr ETDType value = ET_DTYPE_FLOAT64; };
+template <> struct DTypeOf<int64_t> { static constexpr ETDType value = ET_DTYPE_INT64; };
+template <> struct DTypeOf<int32_t> { static constexpr ETDType value = ET_DTYPE_INT32; };
+template <> struct DTypeOf<int16_t> { static constexpr ETDType value = ET_DTYPE_INT16; };
+template <> struct DTypeOf<int8_t> { static constexpr ETDType value = ET_DTYPE_INT8; };
+template <> struct DTypeOf<uint8_t> { static constexpr ETDType value = ET_DTYPE_UINT8; };
+template <> struct DTypeOf<bool> { static constexpr ETDType value = ET_DTYPE_BOOL; };
+
+/**
+ * Non-owning tensor handle. Valid while the owning Tensor / TensorList lives.
+ */
+class TensorView {
+public:
+    TensorView() noexcept = default;
+    explicit TensorView(ETTensor* handle) noexcept : handle_(handle) {}
+
+    ETTensor* get() const noexcept { return handle_; }
+    explicit operator bool() const noexcept { return handle_ != nullptr; }
+
+    ETDType dtype() const noexcept { return et_tensor_dtype(handle_); }
+    int32_t rank() const noexcept { return et_tensor_rank(handle_); }
+
+    Span<const int64_t> shape() const noexcept {
+        return {et_tensor_shape(handle_), static_cast<size_t>(rank())};
+    }
+
+    Span<const uint8_t> bytes() const noexcept {
+        return {static_cast<const uint8_t*>(et_tensor_data(handle_)), et_tensor_data_size(handle_)};
+    }
+
+    /** Typed data. T must match dtype(). */
+    template <typename T>
+    Span<const T> data() const noexcept {
+        assert(DTypeOf<T>::value == dtype());
+        return {static_cast<const T*>(et_tensor_data(handle_)), et_tensor_data_size(handle_) / sizeof(T)};
+    }
+
+    /** Backing fd of a shared-memory tensor (owned by the tensor), else -1. */
+    int32_t shared_fd() const noexcept { return et_tensor_shared_fd(handle_); }
+
+protected:
+    ETTensor* handle_ = nullptr;
+};
+
+/**
+ * Owned tensor.
+ */
+class Tensor : public TensorView {
+public:
+    Tensor() noexcept = default;
+    explicit Tensor(ETTensor* handle) noexcept : TensorView(handle) {}
+    ~Tensor() { et_tensor_free(handle_); }
+
+    Tensor(const Tensor&) = delete;
+    Tensor& operator=(const Tensor&) = delete;
+
+    Tensor(Tensor&& other) noexcept : TensorView(std::exchange(other.handle_, nullptr)) {}
+    Tensor& operator=(Tensor&& other) noexcept {
+        if (this != &other) {
+            et_tensor_free(handle_);
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    /** Give up ownership; the caller frees with et_tensor_free(). */
+    ETTensor* release() noexcept { return std::exchange(handle_, nullptr); }
+
+    /** Create a tensor from raw bytes (copied). */
+    static Result<Tensor> create(const void* data, size_t data_size, Span<const int64_t> shape, ETDType dtype) noexcept {
+        ETTensor* handle = nullptr;
+        Status status = Status::adopt(et_tensor_create(
+            data, data_size, shape.data(), static_cast<int32_t>(shape.size()), dtype, &handle));
+        if (!status) return status;
+        return Tensor(handle);
+    }
+
+    /** Create a tensor from typed data (copied). */
+    template <typename T>
+    static Result<Tensor> create(Span<const T> data, Span<const int64_t> shape) noexcept {
+        return create(data.data(), data.size() * sizeof(T), shape, DTypeOf<T>::value);
+    }
+
+    /** Create a zero-filled shared-memory tensor (et_tensor_create_shared). */
+    static Result<Tensor> create_shared(Span<const int64_t> shape, ETDType dtype) noexcept {
+        ETTensor* handle = nullptr;
+        Status status = Status::adopt(et_tensor_create_shared(
+            shape.data(), static_cast<int32_t>(shape.size()), dtype, &handle));
+        if (!status) return status;
+        return Tensor(handle);
+    }
+
+    /** Map another process's shared-memory tensor; fd stays the caller's. */
+    static Result<Tensor> import_shared(int32_t fd, Span<const int64_t> shape, ETDType dtype) noexcept {
+        ETTensor* handle = nullptr;
+        Status status = Status::adopt(et_tensor_import_shared(
+            fd, shape.data(), static_cast<int32_t>(shape.size()), dtype, &handle));
+        if (!status) return status;
+        return Tensor(handle);
+    }
+
+    /** Writable bytes, e.g. to fill a shared-memory tensor in place. */
+    Span<uint8_t> mutable_bytes() noexcept {
+        return {static_cast<uint8_t*>(et_tensor_mutable_data(handle_)), et_tensor_data_size(handle_)};
+    }
+};
+
+/**
+ * Owned array of tensors, as returned by forward.
+ */
+class TensorList {
+public:
+    TensorList() noexcept = default;
+    TensorList(ETTensor** tensors, int32_t count) noexcept : tensors_(tensors), count_(count) {}
+    ~TensorList() { et_tensor_array_free(tensors_, count_); }
+
+    TensorList(const TensorList&) = delete;
+    TensorList& operator=(const TensorList&) = delete;
+
+    TensorList(TensorList&& other) noexcept
+        : tensors_(std::exchange(other.tensors_, nullptr)), count_(std::exchange(other.count_, 0)) {}
+    TensorList& operator=(TensorList&& other) noexcept {
+        if (this != &other) {
+            et_tensor_array_free(tensors_, count_);
+            tensors_ = std::exchange(other.tensors_, nullptr);
+            count_ = std::exchange(other.count_, 0);
+        }
+        return *this;
+    }
+
+    size_t size() const noexcept { return static_cast<size_t>(count_); }
+    bool empty() const noexcept { return count_ == 0; }
+
+    TensorView operator[](size_t index) const noexcept {
+        assert(index < size());
+        return TensorView(tensors_[index]);
+    }
+
+    /** Raw handles, for passing outputs straight back into forward. */
+    Span<ETTensor* const> handles() const noexcept { return {tensors_, size()}; }
+
+private:
+    ETTensor** tensors_ = nullptr;
+    int32_t count_ = 0;
+};
+
+/* ============================================================================
+ * Load Options
+ * ============================================================================ */
+
+/**
+ * Owned ETLoadOptions. Options may be destroyed right after loading.
+ */
+class LoadOptions {
+public:
+    static Result<LoadOptions> create() noexcept {
+        ETLoadOptions* handle = et_load_options_create();
+        if (!handle) return Status::adopt(nullptr);
+        return LoadOptions(handle);
+    }
+
+    ~LoadOptions() { et_load_options_free(handle_); }
+
+    LoadOptions(const LoadOptions&) = delete;
+    LoadOptions& operator=(const LoadOptions&) = delete;
+
+    LoadOptions(LoadOptions&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    LoadOptions& operator=(LoadOptions&& other) noexcept {
+        if (this != &other) {
+            et_load_options_free(handle_);
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    ETLoadOptions* get() const noexcept { return handle_; }
+
+    Status set_backend_int(ETBackend backend, const char* key, int32_t value) noexcept {
+        return Status::adopt(et_load_options_set_backend_int(handle_, backend, key, value));
+    }
+
+    Status set_backend_bool(ETBackend backend, const char* key, bool value) noexcept {
+        return Status::adopt(et_load_options_set_backend_bool(handle_, backend, key, value ? 1 : 0));
+    }
+
+    Status set_backend_string(ETBackend backend, const char* key, const char* value) noexcept {
+        return Status::adopt(et_load_options_set_backend_string(handle_, backend, key, value));
+    }
+
+    Status set_thread_autotune(Span<const int32_t> candidates = {}, int32_t iterations = 0,
+                               const char* cache_path = nullptr) noexcept {
+        return Status::adopt(et_load_options_set_thread_autotune(
+            handle_, candidates.data(), static_cast<int32_t>(candidates.size()), iterations, cache_path));
+    }
+
+    Status set_xnnpack_workspace_sharing(ETXnnpackWorkspaceSharing mode) noexcept {
+        return Status::adopt(et_load_options_set_xnnpack_workspace_sharing(handle_, mode));
+    }
+
+    Status set_numa_node(int32_t node) noexcept {
+        return Status::adopt(et_load_options_set_numa_node(handle_, node));
+    }
+
+    Status set_huge_pages(ETHugePages mode) noexcept {
+        return Status::adopt(et_load_options_set_huge_pages(handle_, mode));
+    }
+
+    /** Initialize these methods besides forward; empty = every method. */
+    Status set_methods(Span<const char* const> names, bool parallel = true) noexcept {
+        return Status::adopt(et_load_options_set_methods(
+            handle_, names.empty() ? nullptr : names.data(), static_cast<int32_t>(names.size()), parallel ? 1 : 0));
+    }
+
+    Status set_progress_callback(ETLoadProgressCallback callback, void* user_data = nullptr) noexcept {
+        return Status::adopt(et_load_options_set_progress_callback(handle_, callback, user_data));
+    }
+
+    Status set_progress_port(int64_t port) noexcept {
+        return Status::adopt(et_load_options_set_progress_port(handle_, port));
+    }
+
+    /** `sizes` is bucket-major: bucket_count rows of axis_count sizes. */
+    Status set_buckets(Span<const int64_t> sizes, int32_t axis_count,
+                       Span<const ETBucketDim> inputs, Span<const ETBucketDim> outputs = {}) noexcept {
+        int32_t bucket_count = axis_count > 0 ? static_cast<int32_t>(sizes.size()) / axis_count : 0;
+        return Status::adopt(et_load_options_set_buckets(
+            handle_, sizes.data(), bucket_count, axis_count,
+            inputs.data(), static_cast<int32_t>(inputs.size()),
+            outputs.data(), static_cast<int32_t>(outputs.size())));
+    }
+
+    /** Split oversized forward batches across `instances` instances; 0 = off. */
+    /** Empty `inputs` splits input 0 and the inputs sharing its dim 0. */
+    Status set_batch_split(int32_t instances, Span<const int32_t> inputs = {}) noexcept {
+        return Status::adopt(et_load_options_set_batch_split(
+            handle_, instances, inputs.empty() ? nullptr : inputs.data(), static_cast<int32_t>(inputs.size())));
+    }
+
+private:
+    explicit LoadOptions(ETLoadOptions* handle) noexcept : handle_(handle) {}
+
+    ETLoadOptions* handle_ = nullptr;
+};
+
+/* ============================================================================
+ * Module
+ * ============================================================================ */
+
+/**
+ * Owned module.
+ *
+ * Thread Safety: as the C API - one forward at a time per module.
+ */
+class Module {
+public:
+    Module() noexcept = default;
+    explicit Module(ETModule* handle) noexcept : handle_(handle) {}
+    ~Module() { et_module_free(handle_); }
+
+    Module(const Module&) = delete;
+    Module& operator=(const Module&) = delete;
+
+    Module(Module&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Module& operator=(Module&& other) noexcept {
+        if (this != &other) {
+            et_module_free(handle_);
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    ETModule* get() const noexcept { return handle_; }
+
+    /** Give up ownership; the caller frees with et_module_free(). */
+    ETModule* release() noexcept { return std::exchange(handle_, nullptr); }
+
+    /** Load from memory (copied). */
+    static Result<Module> load(Span<const uint8_t> data, const LoadOptions* options = nullptr) noexcept {
+        ETModule* handle = nullptr;
+        Status status = Status::adopt(et_module_load_with_options(
+            data.data(), data.size(), options ? options->get() : nullptr, &handle));
+        if (!status) return status;
+        return Module(handle);
+    }
+
+    /** Load from a .pte file. */
+    static Result<Module> load_file(const char* path, const LoadOptions* options = nullptr) noexcept {
+        ETModule* handle = nullptr;
+        Status status = Status::adopt(et_module_load_file_with_options(
+            path, options ? options->get() : nullptr, &handle));
+        if (!status) return status;
+        return Module(handle);
+    }
+
+    int32_t input_count() const noexcept { return et_module_input_count(handle_); }
+    int32_t output_count() const noexcept { return et_module_output_count(handle_); }
+    int32_t backend() const noexcept { return et_module_backend(handle_); }
+    double load_time_ms() const noexcept { return et_module_load_time_ms(handle_); }
+    int32_t num_threads() const noexcept { return et_module_num_threads(handle_); }
+    bool thread_tuned() const noexcept { return et_module_thread_tuned(handle_) != 0; }
+    double method_init_time_ms(const char* method) const noexcept {
+        return et_module_method_init_time_ms(handle_, method);
+    }
+    int32_t bucket_count() const noexcept { return et_module_bucket_count(handle_); }
+    int64_t bucket_hits(int32_t bucket) const noexcept { return et_module_bucket_hits(handle_, bucket); }
+    int32_t batch_size() const noexcept { return et_module_batch_size(handle_); }
+
+    Result<ETTensorSpec> input_spec(int32_t index) const noexcept {
+        ETTensorSpec spec;
+        Status status = Status::adopt(et_module_input_spec(handle_, index, &spec));
+        if (!status) return status;
+        return spec;
+    }
+
+    Result<ETTensorSpec> output_spec(int32_t index) const noexcept {
+        ETTensorSpec spec;
+        Status status = Status::adopt(et_module_output_spec(handle_, index, &spec));
+        if (!status) return status;
+        return spec;
+    }
+
+    /** Make forward write output `index` into a shared-memory tensor. */
+    Status bind_output(int32_t index, TensorView tensor) noexcept {
+        return Status::adopt(et_module_bind_output(handle_, index, tensor.get()));
+    }
+
+    /** Run forward on raw input handles (no copies of the handle array). */
+    Result<TensorList> forward(Span<ETTensor* const> inputs) noexcept {
+        ETTensor** outputs = nullptr;
+        int32_t output_count = 0;
+        Status status = Status::adopt(et_module_forward(
+            handle_, const_cast<ETTensor**>(inputs.data()), static_cast<int32_t>(inputs.size()),
+            &outputs, &output_count));
+        if (!status) return status;
+        return TensorList(outputs, output_count);
+    }
+
+    /** Run a method initialized with LoadOptions::set_methods(). */
+    Result<TensorList> execute(const char* method, Span<ETTensor* const> inputs) noexcept {
+        ETTensor** outputs = nullptr;
+        int32_t output_count = 0;
+        Status status = Status::adopt(et_module_execute(
+            handle_, method, const_cast<ETTensor**>(inputs.data()), static_cast<int32_t>(inputs.size()),
+            &outputs, &output_count));
+        if (!status) return status;
+        return TensorList(outputs, output_count);
+    }
+
+    /**
+     * Run forward on tensors. Up to kMaxStackInputs input handles are
+     * gathered on the stack; more fall back to a heap array.
+     */
+    Result<TensorList> forward(std::initializer_list<TensorView> inputs) noexcept {
+        static constexpr size_t kMaxStackInputs = 16;
+        if (inputs.size() <= kMaxStackInputs) {
+            std::array<ETTensor*, kMaxStackInputs> handles{};
+            size_t count = 0;
+            for (const TensorView& input : inputs) handles[count++] = input.get();
+            return forward(Span<ETTensor* const>(handles.data(), count));
+        }
+        std::vector<ETTensor*> handles;
+        handles.reserve(inputs.size());
+        for (const TensorView& input : inputs) handles.push_back(input.get());
+        return forward(Span<ETTensor* const>(handles.data(), handles.size()));
+    }
+
+private:
+    ETModule* handle_ = nullptr;
+};
+
+}  // namespace executorch_ffi
+
+#endif  // EXECUTORCH_FFI_HPP
@@ -0,0 +1,473 @@
+/**
+ * @file et_compare.cpp
+ * @brief A/B comparison of two model configurations: latency and output drift
+ *
+ * Usage: et_compare [options] a.pte [b.pte]
+ *
+ * Runs A and B - two exports of a model (different quantization or
+ * delegate), or one file under two load configurations - on identical
+ * inputs and reports:
+ *   - latency percentiles of each side and B's change relative to A
+ *   - per output tensor: max-abs and mean-abs difference and cosine
+ *     similarity of B's output against A's
+ *
+ * With one file, B is the same file; give the sides different settings
+ * with --a-* / --b-* options (with none, the run measures the noise floor):
+ *   --a-threads N, --b-threads N       CPU thread count (load-time calibration
+ *                                      with a single candidate)
+ *   --a-option BACKEND.KEY=VALUE, --b-option ...
+ *                                      backend load option, repeatable; VALUE
+ *                                      true / false / integer / string
+ * Other options:
+ *   --iterations N     timed runs per side (default 50)
+ *   --warmup N         untimed runs per side first (default 3)
+ *   --seed N           input generator seed (default 1)
+ *   --max-abs X        exit 3 if any output's max-abs difference exceeds X
+ *   --min-cosine X     exit 3 if any output's cosine similarity is below X
+ *
+ * Inputs are shaped from A's forward metadata (B must match) and filled
+ * from a seeded generator: floats uniform in [-1, 1], integers in [0, 10),
+ * so embedding lookups stay in range. Outputs are compared on the first run.
+ *
+ * The CPU threadpool is process-wide, so sides with a thread count run one
+ * after the other, each loaded alone; a side without one runs first, on the
+ * process's default thread count. Otherwise both are loaded and runs
+ * alternate A, B, A, B so that thermal and frequency drift hits both sides
+ * alike.
+ */
+
+#include "executorch_ffi.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct BackendOption {
+    ETBackend backend;
+    std::string key;
+    std::string value;
+};
+
+struct Side {
+    const char* label = "A";
+    const char* path = nullptr;
+    int32_t threads = 0;  // 0 = current thread count
+    std::vector<BackendOption> options;
+
+    ETModule* module = nullptr;
+    double load_ms = 0.0;
+    std::vector<double> times;
+
+    // First run's outputs, as doubles
+    struct Output {
+        ETDType dtype;
+        std::vector<int64_t> shape;
+        std::vector<double> values;
+    };
+    std::vector<Output> outputs;
+};
+
+bool check(ETStatus* status, const char* what) {
+    if (status && status->code == ET_OK) {
+        et_status_free(status);
+        return true;
+    }
+    fprintf(stderr, "et_compare: %s: %s\n", what, status && status->message ? status->message : "out of memory");
+    et_status_free(status);
+    return false;
+}
+
+bool parse_backend(const std::string& name, ETBackend* out) {
+    static const struct { const char* name; ETBackend backend; } backends[] = {
+        {"xnnpack", ET_BACKEND_XNNPACK}, {"coreml", ET_BACKEND_COREML}, {"vulkan", ET_BACKEND_VULKAN},
+        {"qnn", ET_BACKEND_QNN},         {"metal", ET_BACKEND_METAL},
+    };
+    for (const auto& entry : backends) {
+        if (name == entry.name) {
+            *out = entry.backend;
+            return true;
+        }
+    }
+    return false;
+}
+
+// BACKEND.KEY=VALUE
+bool parse_option(const char* text, BackendOption* out) {
+    std::string option(text);
+    size_t dot = option.find('.');
+    size_t equals = option.find('=');
+    if (dot == std::string::npos || equals == std::string::npos || equals < dot) return false;
+    out->key = option.substr(dot + 1, equals - dot - 1);
+    out->value = option.substr(equals + 1);
+    return !out->key.empty() && parse_backend(option.substr(0, dot), &out->backend);
+}
+
+bool set_option(ETLoadOptions* options, const BackendOption& option) {
+    std::string what = option.key + "=" + option.value;
+    if (option.value == "true" || option.value == "false") {
+        return check(et_load_options_set_backend_bool(options, option.backend, option.key.c_str(),
+                                                      option.value == "true"), what.c_str());
+    }
+    char* end = nullptr;
+    long number = strtol(option.value.c_str(), &end, 10);
+    if (!option.value.empty() && *end == '\0') {
+        return check(et_load_options_set_backend_int(options, option.backend, option.key.c_str(),
+                                                     static_cast<int32_t>(number)), what.c_str());
+    }
+    return check(et_load_options_set_backend_string(options, option.backend, option.key.c_str(),
+                                                    option.value.c_str()), what.c_str());
+}
+
+bool load(Side& side) {
+    ETLoadOptions* options = et_load_options_create();
+    if (!options) {
+        fprintf(stderr, "et_compare: out of memory\n");
+        return false;
+    }
+    bool ok = true;
+    for (const BackendOption& option : side.options) ok = ok && set_option(options, option);
+    if (ok && side.threads > 0) {
+        ok = check(et_load_options_set_thread_autotune(options, &side.threads, 1, 1, nullptr), "threads");
+    }
+    if (ok) {
+        std::string what = std::string("load ") + side.path;
+        ok = check(et_module_load_file_with_options(side.path, options, &side.module), what.c_str());
+    }
+    et_load_options_free(options);
+    if (!ok) return false;
+
+    side.load_ms = et_module_load_time_ms(side.module);
+    if (side.threads > 0 && et_module_num_threads(side.module) != side.threads) {
+        fprintf(stderr, "et_compare: %s: running with %d threads instead of %d\n",
+                side.label, et_module_num_threads(side.module), side.threads);
+    }
+    return true;
+}
+
+void unload(Side& side) {
+    et_module_free(side.module);
+    side.module = nullptr;
+}
+
+double element(const void* data, ETDType dtype, size_t index) {
+    switch (dtype) {
+        case ET_DTYPE_FLOAT32: return static_cast<const float*>(data)[index];
+        case ET_DTYPE_FLOAT64: return static_cast<const double*>(data)[index];
+        case ET_DTYPE_INT64: return static_cast<double>(static_cast<const int64_t*>(data)[index]);
+        case ET_DTYPE_INT32: return static_cast<const int32_t*>(data)[index];
+        case ET_DTYPE_INT16: return static_cast<const int16_t*>(data)[index];
+        case ET_DTYPE_INT8: return static_cast<const int8_t*>(data)[index];
+        case ET_DTYPE_UINT8: return static_cast<const uint8_t*>(data)[index];
+        case ET_DTYPE_BOOL: return static_cast<const uint8_t*>(data)[index] ? 1.0 : 0.0;
+    }
+    return 0.0;
+}
+
+template <typename T>
+void fill(void* data, size_t count, std::mt19937_64& rng) {
+    T* values = static_cast<T*>(data);
+    if (std::is_floating_point<T>::value) {
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+        for (size_t i = 0; i < count; i++) values[i] = static_cast<T>(distribution(rng));
+    } else {
+        std::uniform_int_distribution<int> distribution(0, 9);
+        for (size_t i = 0; i < count; i++) values[i] = static_cast<T>(distribution(rng));
+    }
+}
+
+bool same_spec(const ETTensorSpec& a, const ETTensorSpec& b) {
+    if (a.dtype != b.dtype || a.rank != b.rank) return false;
+    for (int32_t d = 0; d < a.rank; d++) {
+        if (a.shape[d] != b.shape[d]) return false;
+    }
+    return true;
+}
+
+bool read_specs(const Side& side, std::vector<ETTensorSpec>& specs) {
+    specs.resize(et_module_input_count(side.module));
+    for (size_t i = 0; i < specs.size(); i++) {
+        std::string what = std::string(side.label) + " input " + std::to_string(i);
+        if (!check(et_module_input_spec(side.module, static_cast<int32_t>(i), &specs[i]), what.c_str())) return false;
+    }
+    return true;
+}
+
+bool same_specs(const std::vector<ETTensorSpec>& a, const std::vector<ETTensorSpec>& b) {
+    if (a.size() != b.size()) {
+        fprintf(stderr, "et_compare: A has %zu inputs, B has %zu\n", a.size(), b.size());
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (!same_spec(a[i], b[i])) {
+            fprintf(stderr, "et_compare: input %zu differs between A and B\n", i);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Seeded inputs: the same seed gives the same data on every call
+bool make_inputs(const std::vector<ETTensorSpec>& specs, uint64_t seed, std::vector<ETTensor*>& inputs) {
+    std::mt19937_64 rng(seed);
+    for (size_t i = 0; i < specs.size(); i++) {
+        const ETTensorSpec& spec = specs[i];
+        std::string what = "input " + std::to_string(i);
+        ETTensor* tensor = nullptr;
+        if (!check(et_tensor_create(nullptr, spec.nbytes, spec.shape, spec.rank, spec.dtype, &tensor), what.c_str())) {
+            return false;
+        }
+        inputs.push_back(tensor);
+
+        void* data = et_tensor_mutable_data(tensor);
+        size_t elements = et_tensor_element_count(tensor);
+        switch (spec.dtype) {
+            case ET_DTYPE_FLOAT32: fill<float>(data, elements, rng); break;
+            case ET_DTYPE_FLOAT64: fill<double>(data, elements, rng); break;
+            case ET_DTYPE_INT64: fill<int64_t>(data, elements, rng); break;
+            case ET_DTYPE_INT32: fill<int32_t>(data, elements, rng); break;
+            case ET_DTYPE_INT16: fill<int16_t>(data, elements, rng); break;
+            case ET_DTYPE_INT8: fill<int8_t>(data, elements, rng); break;
+            case ET_DTYPE_UINT8: fill<uint8_t>(data, elements, rng); break;
+            case ET_DTYPE_BOOL: {
+                std::bernoulli_distribution distribution(0.5);
+                for (size_t e = 0; e < elements; e++) static_cast<uint8_t*>(data)[e] = distribution(rng);
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+void free_inputs(std::vector<ETTensor*>& inputs) {
+    for (ETTensor* input : inputs) et_tensor_free(input);
+    inputs.clear();
+}
+
+// One forward; keeps the outputs of the side's first run. Returns false on failure.
+bool run(Side& side, std::vector<ETTensor*>& inputs, bool timed) {
+    ETTensor** outputs = nullptr;
+    int32_t output_count = 0;
+    auto start = std::chrono::steady_clock::now();
+    ETStatus* status = et_module_forward(side.module, inputs.data(), static_cast<int32_t>(inputs.size()),
+                                         &outputs, &output_count);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::string what = std::string(side.label) + " forward";
+    if (!check(status, what.c_str())) return false;
+
+    if (timed) side.times.push_back(ms);
+    if (side.outputs.empty()) {
+        for (int32_t i = 0; i < output_count; i++) {
+            Side::Output output;
+            output.dtype = et_tensor_dtype(outputs[i]);
+            output.shape.assign(et_tensor_shape(outputs[i]), et_tensor_shape(outputs[i]) + et_tensor_rank(outputs[i]));
+            size_t elements = et_tensor_element_count(outputs[i]);
+            output.values.resize(elements);
+            for (size_t e = 0; e < elements; e++) output.values[e] = element(et_tensor_data(outputs[i]), output.dtype, e);
+            side.outputs.push_back(std::move(output));
+        }
+    }
+    et_tensor_array_free(outputs, output_count);
+    return true;
+}
+
+double percentile(const std::vector<double>& sorted, double q) {
+    return sorted[std::min(sorted.size() - 1, static_cast<size_t>(q * sorted.size()))];
+}
+
+void print_latency(Side& a, Side& b) {
+    std::sort(a.times.begin(), a.times.end());
+    std::sort(b.times.begin(), b.times.end());
+    static const struct { const char* name; double q; } stats[] = {
+        {"min", 0.0}, {"p10", 0.1}, {"p50", 0.5}, {"p90", 0.9}, {"p99", 0.99}, {"max", 1.0},
+    };
+    auto mean = [](const std::vector<double>& times) {
+        double sum = 0;
+        for (double t : times) sum += t;
+        return sum / times.size();
+    };
+
+    printf("\nLatency (ms, %zu runs per side)\n", a.times.size());
+    printf("  %-6s %10s %10s %9s\n", "", "A", "B", "B vs A");
+    for (const auto& stat : stats) {
+        double va = percentile(a.times, stat.q);
+        double vb = percentile(b.times, stat.q);
+        printf("  %-6s %10.3f %10.3f %+8.1f%%\n", stat.name, va, vb, va > 0 ? (vb - va) / va * 100.0 : 0.0);
+    }
+    double ma = mean(a.times);
+    double mb = mean(b.times);
+    printf("  %-6s %10.3f %10.3f %+8.1f%%\n", "mean", ma, mb, ma > 0 ? (mb - ma) / ma * 100.0 : 0.0);
+
+    // A median shift inside A's own p10-p90 spread is likely noise
+    double a50 = percentile(a.times, 0.5);
+    double b50 = percentile(b.times, 0.5);
+    double spread = percentile(a.times, 0.9) - percentile(a.times, 0.1);
+    const char* verdict = std::fabs(b50 - a50) <= spread ? "within A's p10-p90 spread"
+                        : b50 < a50 ? "B faster" : "B slower";
+    printf("  p50 %s: %.3f ms (%s)\n", b50 <= a50 ? "gain" : "loss", std::fabs(b50 - a50), verdict);
+}
+
+std::string shape_text(const std::vector<int64_t>& shape) {
+    std::string text = "[";
+    for (size_t d = 0; d < shape.size(); d++) text += (d ? "," : "") + std::to_string(shape[d]);
+    return text + "]";
+}
+
+// Returns false if an output fails a tolerance
+bool print_drift(const Side& a, const Side& b, double max_abs_limit, double min_cosine_limit) {
+    printf("\nOutput drift (B against A)\n");
+    printf("  %-3s %-20s %12s %12s %10s\n", "#", "shape", "max-abs", "mean-abs", "cosine");
+    bool ok = true;
+    if (a.outputs.size() != b.outputs.size()) {
+        printf("  output count differs: A %zu, B %zu\n", a.outputs.size(), b.outputs.size());
+        ok = false;
+    }
+    for (size_t i = 0; i < std::min(a.outputs.size(), b.outputs.size()); i++) {
+        const Side::Output& x = a.outputs[i];
+        const Side::Output& y = b.outputs[i];
+        if (x.shape != y.shape) {
+            printf("  %-3zu shape differs: A %s, B %s\n", i, shape_text(x.shape).c_str(), shape_text(y.shape).c_str());
+            ok = false;
+            continue;
+        }
+        double max_abs = 0, sum_abs = 0, dot = 0, norm_x = 0, norm_y = 0;
+        for (size_t e = 0; e < x.values.size(); e++) {
+            double diff = std::fabs(x.values[e] - y.values[e]);
+            if (std::isnan(diff)) diff = INFINITY;
+            max_abs = std::max(max_abs, diff);
+            sum_abs += diff;
+            dot += x.values[e] * y.values[e];
+            norm_x += x.values[e] * x.values[e];
+            norm_y += y.values[e] * y.values[e];
+        }
+        double mean_abs = x.values.empty() ? 0.0 : sum_abs / x.values.size();
+        // Two all-zero outputs match; one all-zero output does not
+        double cosine = norm_x == 0 && norm_y == 0 ? 1.0
+                      : norm_x == 0 || norm_y == 0 ? 0.0 : dot / std::sqrt(norm_x * norm_y);
+
+        bool pass = !(max_abs > max_abs_limit) && !(cosine < min_cosine_limit);
+        printf("  %-3zu %-20s %12.4g %12.4g %10.6f%s\n", i, shape_text(x.shape).c_str(), max_abs, mean_abs, cosine,
+               pass ? "" : "  FAIL");
+        if (x.dtype != y.dtype) printf("      dtype differs: A %d, B %d\n", x.dtype, y.dtype);
+        ok = ok && pass;
+    }
+    return ok;
+}
+
+void usage() {
+    fprintf(stderr,
+            "usage: et_compare [--iterations N] [--warmup N] [--seed N] [--max-abs X] [--min-cosine X]\n"
+            "                  [--a-threads N] [--b-threads N] [--a-option BACKEND.KEY=VALUE]...\n"
+            "                  [--b-option BACKEND.KEY=VALUE]... a.pte [b.pte]\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Side a, b;
+    a.label = "A";
+    b.label = "B";
+    int iterations = 50;
+    int warmup = 3;
+    uint64_t seed = 1;
+    double max_abs_limit = INFINITY;
+    double min_cosine_limit = -INFINITY;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool has_value = i + 1 < argc;
+        BackendOption option;
+        if (strcmp(arg, "--iterations") == 0 && has_value) iterations = std::max(1, atoi(argv[++i]));
+        else if (strcmp(arg, "--warmup") == 0 && has_value) warmup = std::max(0, atoi(argv[++i]));
+        else if (strcmp(arg, "--seed") == 0 && has_value) seed = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(arg, "--max-abs") == 0 && has_value) max_abs_limit = atof(argv[++i]);
+        else if (strcmp(arg, "--min-cosine") == 0 && has_value) min_cosine_limit = atof(argv[++i]);
+        else if (strcmp(arg, "--a-threads") == 0 && has_value) a.threads = std::max(0, atoi(argv[++i]));
+        else if (strcmp(arg, "--b-threads") == 0 && has_value) b.threads = std::max(0, atoi(argv[++i]));
+        else if ((strcmp(arg, "--a-option") == 0 || strcmp(arg, "--b-option") == 0) && has_value) {
+            if (!parse_option(argv[++i], &option)) {
+                fprintf(stderr, "et_compare: bad option '%s' (expected BACKEND.KEY=VALUE)\n", argv[i]);
+                return 2;
+            }
+            (arg[2] == 'a' ? a : b).options.push_back(option);
+        }
+        else if (arg[0] != '-' && !a.path) a.path = arg;
+        else if (arg[0] != '-' && !b.path) b.path = arg;
+        else {
+            usage();
+            return 2;
+        }
+    }
+    if (!a.path) {
+        usage();
+        return 2;
+    }
+    if (!b.path) b.path = a.path;
+
+    std::vector<ETTensor*> inputs;
+    std::vector<ETTensorSpec> specs_a, specs_b;
+    auto cleanup = [&](int code) {
+        free_inputs(inputs);
+        unload(a);
+        unload(b);
+        return code;
+    };
+
+    if (a.threads > 0 || b.threads > 0) {
+        // Sequential: each side owns the threadpool while it runs, with its
+        // own copy of the (identical) inputs. A thread count outlives its
+        // module, so a side without one runs first, on the original count.
+        Side* first = &a;
+        Side* second = &b;
+        if (a.threads > 0 && b.threads == 0) std::swap(first, second);
+        std::vector<ETTensorSpec>& first_specs = first == &a ? specs_a : specs_b;
+        std::vector<ETTensorSpec>& second_specs = first == &a ? specs_b : specs_a;
+
+        if (!load(*first) || !read_specs(*first, first_specs) || !make_inputs(first_specs, seed, inputs)) {
+            return cleanup(1);
+        }
+        for (int run_index = 0; run_index < warmup + iterations; run_index++) {
+            if (!run(*first, inputs, run_index >= warmup)) return cleanup(1);
+        }
+        first->threads = et_module_num_threads(first->module);
+        unload(*first);
+        free_inputs(inputs);
+
+        if (!load(*second) || !read_specs(*second, second_specs) || !same_specs(specs_a, specs_b) ||
+            !make_inputs(second_specs, seed, inputs)) {
+            return cleanup(1);
+        }
+        for (int run_index = 0; run_index < warmup + iterations; run_index++) {
+            if (!run(*second, inputs, run_index >= warmup)) return cleanup(1);
+        }
+        second->threads = et_module_num_threads(second->module);
+    } else {
+        if (!load(a) || !load(b) || !read_specs(a, specs_a) || !read_specs(b, specs_b) ||
+            !same_specs(specs_a, specs_b) || !make_inputs(specs_a, seed, inputs)) {
+            return cleanup(1);
+        }
+        a.threads = et_module_num_threads(a.module);
+        b.threads = et_module_num_threads(b.module);
+        for (int run_index = 0; run_index < warmup + iterations; run_index++) {
+            bool timed = run_index >= warmup;
+            if (!run(a, inputs, timed) || !run(b, inputs, timed)) return cleanup(1);
+        }
+    }
+
+    for (const Side* side : {&a, &b}) {
+        printf("%s: %s  (%d threads, %zu backend options, load %.2f ms)\n", side->label, side->path,
+               side->threads, side->options.size(), side->load_ms);
+    }
+    print_latency(a, b);
+    bool ok = print_drift(a, b, max_abs_limit, min_cosine_limit);
+    return cleanup(ok ? 0 : 3);
+}
@@ -0,0 +1,366 @@
+/**
+ * @file et_inspect.cpp
+ * @brief Performance triage for .pte programs without a Python environment
+ *
+ * Usage: et_inspect [--bench] [--iterations N] model.pte
+ *
+ * Prints what decides how a program performs on device:
+ *   - file layout: program flatbuffer size and each data segment with what
+ *     uses it (delegate payload, constants, named data)
+ *   - constant data sizes (segment and inline)
+ *   - per method: input / output specs with shape dynamism, memory-planned
+ *     buffer sizes, instruction mix, delegate partitions with payload sizes,
+ *     and a histogram of the operators left to the CPU kernel library -
+ *     typically the first place to look when a delegated model is slow
+ *
+ * --bench loads the program through the FFI library and times forward on
+ * zero-filled inputs (load time, then latency percentiles over N runs after
+ * one warm-up run).
+ *
+ * The program is read with ExecuTorch's generated flatbuffer accessors
+ * (program_schema); nothing is executed without --bench.
+ */
+
+#include "executorch_ffi.h"
+
+#include <executorch/schema/program_generated.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+namespace fb = executorch_flatbuffer;
+
+std::string format_bytes(uint64_t bytes) {
+    char text[32];
+    if (bytes >= (1ull << 30)) snprintf(text, sizeof(text), "%.2f GB", bytes / double(1ull << 30));
+    else if (bytes >= (1ull << 20)) snprintf(text, sizeof(text), "%.2f MB", bytes / double(1ull << 20));
+    else if (bytes >= (1ull << 10)) snprintf(text, sizeof(text), "%.1f KB", bytes / double(1ull << 10));
+    else snprintf(text, sizeof(text), "%llu B", static_cast<unsigned long long>(bytes));
+    return text;
+}
+
+// ExecuTorch ScalarType numbering (c10)
+const char* scalar_type_name(int type) {
+    static const char* names[] = {"uint8", "int8", "int16", "int32", "int64", "float16", "float32",
+                                  "float64", "complex32", "complex64", "complex128", "bool",
+                                  "qint8", "quint8", "qint32", "bfloat16"};
+    if (type >= 0 && type < static_cast<int>(sizeof(names) / sizeof(names[0]))) return names[type];
+    return "other";
+}
+
+std::string describe_value(const fb::ExecutionPlan* plan, int32_t index) {
+    const fb::EValue* value = plan->values() && index >= 0 && static_cast<uint32_t>(index) < plan->values()->size()
+                                  ? plan->values()->Get(index)
+                                  : nullptr;
+    if (!value) return "?";
+    if (value->val_type() != fb::KernelTypes::Tensor) return "non-tensor";
+
+    const fb::Tensor* tensor = value->val_as_Tensor();
+    std::string text = scalar_type_name(static_cast<int>(tensor->scalar_type()));
+    text += "[";
+    if (tensor->sizes()) {
+        for (uint32_t d = 0; d < tensor->sizes()->size(); d++) {
+            text += (d ? "," : "") + std::to_string(tensor->sizes()->Get(d));
+        }
+    }
+    text += "]";
+    switch (tensor->shape_dynamism()) {
+        case fb::TensorShapeDynamism::DYNAMIC_BOUND: text += " (dynamic, upper bound)"; break;
+        case fb::TensorShapeDynamism::DYNAMIC_UNBOUND: text += " (dynamic, unbound)"; break;
+        default: break;
+    }
+    if (!tensor->allocation_info() && tensor->data_buffer_idx() == 0) text += " (not memory-planned)";
+    return text;
+}
+
+void print_method(const fb::Program* program, const fb::ExecutionPlan* plan) {
+    printf("\nMethod %s\n", plan->name() ? plan->name()->c_str() : "?");
+
+    if (plan->inputs()) {
+        for (uint32_t i = 0; i < plan->inputs()->size(); i++) {
+            printf("  input %u:  %s\n", i, describe_value(plan, plan->inputs()->Get(i)).c_str());
+        }
+    }
+    if (plan->outputs()) {
+        for (uint32_t i = 0; i < plan->outputs()->size(); i++) {
+            printf("  output %u: %s\n", i, describe_value(plan, plan->outputs()->Get(i)).c_str());
+        }
+    }
+
+    // Buffer 0 is reserved; the rest are the planned memory arenas
+    uint64_t planned = 0;
+    std::string buffers;
+    if (plan->non_const_buffer_sizes()) {
+        for (uint32_t i = 1; i < plan->non_const_buffer_sizes()->size(); i++) {
+            uint64_t size = static_cast<uint64_t>(plan->non_const_buffer_sizes()->Get(i));
+            planned += size;
+            buffers += (buffers.empty() ? "" : ", ") + format_bytes(size);
+        }
+    }
+    printf("  planned memory: %s%s%s%s\n", format_bytes(planned).c_str(),
+           buffers.empty() ? "" : " (", buffers.c_str(), buffers.empty() ? "" : ")");
+
+    // Instruction mix and the operators kernel calls resolve to
+    size_t kernel_calls = 0, delegate_calls = 0, other = 0;
+    std::map<std::string, size_t> histogram;
+    if (plan->chains()) {
+        for (const fb::Chain* chain : *plan->chains()) {
+            if (!chain->instructions()) continue;
+            for (const fb::Instruction* instruction : *chain->instructions()) {
+                switch (instruction->instr_args_type()) {
+                    case fb::InstructionArguments::KernelCall: {
+                        kernel_calls++;
+                        int32_t op_index = instruction->instr_args_as_KernelCall()->op_index();
+                        std::string name = "?";
+                        if (plan->operators() && op_index >= 0 &&
+                            static_cast<uint32_t>(op_index) < plan->operators()->size()) {
+                            const fb::Operator* op = plan->operators()->Get(op_index);
+                            name = op->name() ? op->name()->str() : "?";
+                            if (op->overload() && op->overload()->size()) name += "." + op->overload()->str();
+                        }
+                        histogram[name]++;
+                        break;
+                    }
+                    case fb::InstructionArguments::DelegateCall:
+                        delegate_calls++;
+                        break;
+                    default:
+                        other++;
+                        break;
+                }
+            }
+        }
+    }
+    printf("  instructions: %zu (kernel calls %zu, delegate calls %zu, other %zu)\n",
+           kernel_calls + delegate_calls + other, kernel_calls, delegate_calls, other);
+
+    // Delegate partitions, grouped by backend
+    if (plan->delegates() && plan->delegates()->size()) {
+        std::map<std::string, std::pair<size_t, uint64_t>> backends;  // id -> (partitions, payload)
+        for (const fb::BackendDelegate* delegate : *plan->delegates()) {
+            auto& entry = backends[delegate->id() ? delegate->id()->str() : "?"];
+            entry.first++;
+            const fb::BackendDelegateDataReference* processed = delegate->processed();
+            if (!processed) continue;
+            if (processed->location() == fb::DataLocation::INLINE) {
+                if (program->backend_delegate_data() && processed->index() < program->backend_delegate_data()->size()) {
+                    const auto* data = program->backend_delegate_data()->Get(processed->index())->data();
+                    entry.second += data ? data->size() : 0;
+                }
+            } else if (program->segments() && processed->index() < program->segments()->size()) {
+                entry.second += program->segments()->Get(processed->index())->size();
+            }
+        }
+        printf("  delegates:\n");
+        for (const auto& backend : backends) {
+            printf("    %-24s %zu partition(s), %s payload\n", backend.first.c_str(), backend.second.first,
+                   format_bytes(backend.second.second).c_str());
+        }
+    } else {
+        printf("  delegates: none (everything runs on the CPU kernel library)\n");
+    }
+
+    if (!histogram.empty()) {
+        std::vector<std::pair<std::string, size_t>> ops(histogram.begin(), histogram.end());
+        std::stable_sort(ops.begin(), ops.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+        printf("  CPU kernel operators (%zu distinct):\n", ops.size());
+        for (const auto& op : ops) printf("    %6zu  %s\n", op.second, op.first.c_str());
+    }
+}
+
+void print_layout(const fb::Program* program, size_t file_size, const uint8_t* data) {
+    // Extended header after the flatbuffer root offset and identifier:
+    // "eh00", u32 length, u64 program size, u64 segment base offset (LE)
+    uint64_t program_size = file_size;
+    uint64_t segment_base = 0;
+    if (file_size >= 32 && memcmp(data + 8, "eh00", 4) == 0) {
+        memcpy(&program_size, data + 16, sizeof(program_size));
+        memcpy(&segment_base, data + 24, sizeof(segment_base));
+    }
+    printf("File: %s, program flatbuffer %s, schema version %u\n", format_bytes(file_size).c_str(),
+           format_bytes(program_size).c_str(), program->version());
+
+    // What each segment holds
+    size_t segment_count = program->segments() ? program->segments()->size() : 0;
+    std::vector<std::string> uses(segment_count);
+    auto add_use = [&](uint32_t index, const std::string& use) {
+        if (index < uses.size()) uses[index] += (uses[index].empty() ? "" : ", ") + use;
+    };
+    if (program->execution_plan()) {
+        for (const fb::ExecutionPlan* plan : *program->execution_plan()) {
+            if (!plan->delegates()) continue;
+            for (const fb::BackendDelegate* delegate : *plan->delegates()) {
+                const fb::BackendDelegateDataReference* processed = delegate->processed();
+                if (processed && processed->location() == fb::DataLocation::SEGMENT) {
+                    add_use(processed->index(), "delegate " + (delegate->id() ? delegate->id()->str() : "?") +
+                                                    " (" + (plan->name() ? plan->name()->str() : "?") + ")");
+                }
+            }
+        }
+    }
+    if (program->constant_segment() && program->constant_segment()->offsets() &&
+        program->constant_segment()->offsets()->size() > 1) {
+        add_use(program->constant_segment()->segment_index(), "constants");
+    }
+    if (program->mutable_data_segments()) {
+        for (const fb::SubsegmentOffsets* mutable_data : *program->mutable_data_segments()) {
+            add_use(mutable_data->segment_index(), "mutable data");
+        }
+    }
+    if (program->named_data()) {
+        for (const fb::NamedData* named : *program->named_data()) {
+            add_use(named->segment_index(), "named data " + (named->key() ? named->key()->str() : "?"));
+        }
+    }
+
+    printf("\nSegments: %zu (base offset %llu)\n", segment_count, static_cast<unsigned long long>(segment_base));
+    for (size_t i = 0; i < segment_count; i++) {
+        const fb::DataSegment* segment = program->segments()->Get(i);
+        printf("  #%-3zu offset %-12llu size %-10s %s\n", i, static_cast<unsigned long long>(segment->offset()),
+               format_bytes(segment->size()).c_str(), uses[i].empty() ? "-" : uses[i].c_str());
+    }
+
+    // Constant data: one segment of sub-buffers (current exporter) and / or
+    // inline buffers in the flatbuffer (older programs)
+    uint64_t segment_constants = 0;
+    size_t constant_buffers = 0;
+    if (program->constant_segment() && program->constant_segment()->offsets()) {
+        uint32_t index = program->constant_segment()->segment_index();
+        constant_buffers = program->constant_segment()->offsets()->size();
+        if (constant_buffers > 1 && index < segment_count) segment_constants = program->segments()->Get(index)->size();
+        constant_buffers = constant_buffers ? constant_buffers - 1 : 0;  // Buffer 0 is reserved
+    }
+    uint64_t inline_constants = 0;
+    if (program->constant_buffer()) {
+        for (const fb::Buffer* buffer : *program->constant_buffer()) {
+            inline_constants += buffer->storage() ? buffer->storage()->size() : 0;
+        }
+    }
+    printf("Constant data: %s in segment (%zu buffers), %s inline\n", format_bytes(segment_constants).c_str(),
+           constant_buffers, format_bytes(inline_constants).c_str());
+}
+
+// Loads through the FFI library and times forward on zero-filled inputs
+int bench(const char* path, int iterations) {
+    printf("\nBenchmark (forward, %d iterations)\n", iterations);
+
+    ETModule* module = nullptr;
+    ETStatus* status = et_module_load_file(path, &module);
+    if (!status || status->code != ET_OK) {
+        fprintf(stderr, "et_inspect: load failed: %s\n", status && status->message ? status->message : "out of memory");
+        et_status_free(status);
+        return 1;
+    }
+    et_status_free(status);
+    printf("  load: %.2f ms (program + method init)\n", et_module_load_time_ms(module));
+
+    std::vector<ETTensor*> inputs;
+    for (int32_t i = 0; i < et_module_input_count(module); i++) {
+        ETTensorSpec spec;
+        ETTensor* tensor = nullptr;
+        status = et_module_input_spec(module, i, &spec);
+        if (status && status->code == ET_OK) {
+            et_status_free(status);
+            status = et_tensor_create(nullptr, spec.nbytes, spec.shape, spec.rank, spec.dtype, &tensor);
+        }
+        if (!status || status->code != ET_OK) {
+            fprintf(stderr, "et_inspect: input %d: %s\n", i, status && status->message ? status->message : "out of memory");
+            et_status_free(status);
+            for (ETTensor* input : inputs) et_tensor_free(input);
+            et_module_free(module);
+            return 1;
+        }
+        et_status_free(status);
+        inputs.push_back(tensor);
+    }
+
+    std::vector<double> times;
+    int result = 0;
+    for (int run = 0; run <= iterations; run++) {
+        ETTensor** outputs = nullptr;
+        int32_t output_count = 0;
+        auto start = std::chrono::steady_clock::now();
+        status = et_module_forward(module, inputs.data(), static_cast<int32_t>(inputs.size()), &outputs, &output_count);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (!status || status->code != ET_OK) {
+            fprintf(stderr, "et_inspect: forward failed: %s\n", status && status->message ? status->message : "out of memory");
+            et_status_free(status);
+            result = 1;
+            break;
+        }
+        et_status_free(status);
+        et_tensor_array_free(outputs, output_count);
+        if (run == 0) printf("  first run: %.3f ms\n", ms);
+        else times.push_back(ms);
+    }
+
+    if (!times.empty()) {
+        std::sort(times.begin(), times.end());
+        auto at = [&](double q) { return times[std::min(times.size() - 1, static_cast<size_t>(q * times.size()))]; };
+        double mean = 0;
+        for (double t : times) mean += t;
+        mean /= times.size();
+        printf("  latency: min %.3f  p50 %.3f  p90 %.3f  max %.3f  mean %.3f ms\n",
+               times.front(), at(0.5), at(0.9), times.back(), mean);
+    }
+
+    for (ETTensor* input : inputs) et_tensor_free(input);
+    et_module_free(module);
+    return result;
+}
+
+void usage() {
+    fprintf(stderr, "usage: et_inspect [--bench] [--iterations N] model.pte\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    bool run_bench = false;
+    int iterations = 20;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--bench") == 0) run_bench = true;
+        else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) iterations = std::max(1, atoi(argv[++i]));
+        else if (argv[i][0] != '-' && !path) path = argv[i];
+        else {
+            usage();
+            return 2;
+        }
+    }
+    if (!path) {
+        usage();
+        return 2;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!file.good() && !file.eof()) {
+        fprintf(stderr, "et_inspect: cannot read %s\n", path);
+        return 1;
+    }
+    flatbuffers::Verifier verifier(data.data(), data.size());
+    if (data.size() < 8 ||
+        !fb::ProgramBufferHasIdentifier(data.data()) || !fb::VerifyProgramBuffer(verifier)) {
+        fprintf(stderr, "et_inspect: %s is not a valid ExecuTorch program\n", path);
+        return 1;
+    }
+
+    const fb::Program* program = fb::GetProgram(data.data());
+    print_layout(program, data.size(), data.data());
+    if (program->execution_plan()) {
+        for (const fb::ExecutionPlan* plan : *program->execution_plan()) print_method(program, plan);
+    }
+
+    return run_bench ? bench(path, iterations) : 0;
+}
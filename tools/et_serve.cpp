@@ -0,0 +1,954 @@
+/**
+ * @file et_serve.cpp
+ * @brief Local inference daemon: one set of loaded models shared by many processes
+ *
+ * Loads the models listed in a config file once and serves forward requests
+ * over a Unix domain socket (wire format: et_serve_protocol.h). App processes
+ * on the same machine share the loaded programs, planned memory and threads
+ * instead of each loading their own copy.
+ *
+ * Usage: et_serve --config FILE [--socket PATH] [--debug]
+ *
+ * Config file, one directive per line ('#' starts a comment):
+ *
+ *   socket /run/et_serve.sock
+ *   model detector /models/detector.pte batch=8 wait_us=2000
+ *   model embedder /models/embed.pte numa=0 huge_pages=transparent
+ *
+ * Model options:
+ *   batch=N        Dynamic batching: the model was exported with batch size N
+ *                  in dim 0 of every input and output. Requests of fewer rows
+ *                  queued within wait_us are concatenated into one forward
+ *                  call and the outputs split back per request.
+ *   pad=0|1        Pad a partial batch to N rows (default 1, for static
+ *                  shapes); 0 runs the exact row count (dynamic dim 0).
+ *   wait_us=N      How long the first request of a batch waits for more
+ *                  (default 1000).
+ *   numa=N         Place the model on NUMA node N (et_load_options_set_numa_node).
+ *   huge_pages=off|transparent|explicit  (et_load_options_set_huge_pages)
+ *
+ * Each model has one worker thread running its forward calls; every client
+ * connection has its own thread. SIGINT / SIGTERM shut the server down.
+ */
+
+#include "executorch_ffi.h"
+#include "et_serve_protocol.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::atomic<bool> g_stop{false};
+
+void on_signal(int) { g_stop = true; }
+
+const char* dtype_name(ETDType dtype) {
+    switch (dtype) {
+        case ET_DTYPE_FLOAT32: return "float32";
+        case ET_DTYPE_FLOAT64: return "float64";
+        case ET_DTYPE_INT64: return "int64";
+        case ET_DTYPE_INT32: return "int32";
+        case ET_DTYPE_INT16: return "int16";
+        case ET_DTYPE_INT8: return "int8";
+        case ET_DTYPE_UINT8: return "uint8";
+        case ET_DTYPE_BOOL: return "bool";
+        default: return "unknown";
+    }
+}
+
+// Takes ownership of an ETStatus; true if it was OK
+bool check(ETStatus* status, std::string* error) {
+    if (!status) {
+        if (error) *error = "out of memory";
+        return false;
+    }
+    bool ok = status->code == ET_OK;
+    if (!ok && error) *error = status->message ? status->message : "unknown error";
+    et_status_free(status);
+    return ok;
+}
+
+/* ============================================================================
+ * Config
+ * ============================================================================ */
+
+struct ModelConfig {
+    std::string name;
+    std::string path;
+    int64_t batch = 1;
+    bool pad = true;
+    int64_t wait_us = 1000;
+    int32_t numa_node = -1;
+    ETHugePages huge_pages = ET_HUGE_PAGES_OFF;
+};
+
+struct Config {
+    std::string socket_path = "/tmp/et_serve.sock";
+    std::vector<ModelConfig> models;
+};
+
+bool parse_model_option(const std::string& option, ModelConfig* model) {
+    size_t eq = option.find('=');
+    if (eq == std::string::npos) return false;
+    std::string key = option.substr(0, eq);
+    std::string value = option.substr(eq + 1);
+    char* end = nullptr;
+    long long number = strtoll(value.c_str(), &end, 10);
+    bool numeric = !value.empty() && *end == '\0';
+
+    if (key == "batch" && numeric && number >= 1) model->batch = number;
+    else if (key == "pad" && numeric) model->pad = number != 0;
+    else if (key == "wait_us" && numeric && number >= 0) model->wait_us = number;
+    else if (key == "numa" && numeric) model->numa_node = static_cast<int32_t>(number);
+    else if (key == "huge_pages" && value == "off") model->huge_pages = ET_HUGE_PAGES_OFF;
+    else if (key == "huge_pages" && value == "transparent") model->huge_pages = ET_HUGE_PAGES_TRANSPARENT;
+    else if (key == "huge_pages" && value == "explicit") model->huge_pages = ET_HUGE_PAGES_EXPLICIT;
+    else return false;
+    return true;
+}
+
+bool parse_config(const char* path, Config* config, std::string* error) {
+    std::ifstream file(path);
+    if (!file) {
+        *error = std::string("cannot open ") + path;
+        return false;
+    }
+    std::string line;
+    for (int line_number = 1; std::getline(file, line); line_number++) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream words(line);
+        std::string directive;
+        if (!(words >> directive)) continue;
+
+        bool ok = true;
+        if (directive == "socket") {
+            ok = static_cast<bool>(words >> config->socket_path);
+        } else if (directive == "model") {
+            ModelConfig model;
+            ok = static_cast<bool>(words >> model.name >> model.path);
+            for (std::string option; ok && words >> option;) ok = parse_model_option(option, &model);
+            for (const auto& other : config->models) ok = ok && other.name != model.name;
+            if (ok) config->models.push_back(model);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            *error = std::string(path) + ":" + std::to_string(line_number) + ": invalid line: " + line;
+            return false;
+        }
+    }
+    if (config->models.empty()) {
+        *error = std::string(path) + ": no models configured";
+        return false;
+    }
+    return true;
+}
+
+/* ============================================================================
+ * Metrics
+ * ============================================================================ */
+
+// Percentiles over the most recent samples
+class LatencyWindow {
+public:
+    void record(double ms) {
+        if (samples_.size() < kSize) samples_.push_back(ms);
+        else samples_[next_] = ms;
+        next_ = (next_ + 1) % kSize;
+    }
+
+    double percentile(double q) const {
+        if (samples_.empty()) return 0.0;
+        std::vector<double> sorted = samples_;
+        size_t index = std::min(sorted.size() - 1, static_cast<size_t>(q * sorted.size()));
+        std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+        return sorted[index];
+    }
+
+private:
+    static constexpr size_t kSize = 1024;
+    std::vector<double> samples_;
+    size_t next_ = 0;
+};
+
+struct ModelMetrics {
+    uint64_t requests = 0;
+    uint64_t errors = 0;
+    uint64_t batches = 0;
+    uint64_t batch_rows = 0;
+    LatencyWindow queue_ms;
+    LatencyWindow inference_ms;
+};
+
+/* ============================================================================
+ * Served Model
+ * ============================================================================ */
+
+struct Reply {
+    int32_t code = ET_OK;
+    std::string message;
+    std::vector<ETTensor*> outputs;  // Owned by the receiver
+};
+
+struct Request {
+    std::vector<ETTensor*> inputs;   // Owned
+    int64_t rows = 1;
+    Clock::time_point enqueued;
+    std::promise<Reply> reply;
+
+    ~Request() {
+        for (ETTensor* tensor : inputs) et_tensor_free(tensor);
+    }
+};
+
+class ServedModel {
+public:
+    static std::unique_ptr<ServedModel> load(const ModelConfig& config, std::string* error) {
+        std::unique_ptr<ServedModel> model(new ServedModel(config));
+
+        ETLoadOptions* options = et_load_options_create();
+        if (!options) {
+            *error = "out of memory";
+            return nullptr;
+        }
+        bool ok = true;
+        if (config.numa_node >= 0) ok = check(et_load_options_set_numa_node(options, config.numa_node), error);
+        if (ok) ok = check(et_load_options_set_huge_pages(options, config.huge_pages), error);
+        if (ok) ok = check(et_module_load_file_with_options(config.path.c_str(), options, &model->module_), error);
+        et_load_options_free(options);
+        if (!ok) return nullptr;
+
+        model->inputs_.resize(et_module_input_count(model->module_));
+        model->outputs_.resize(et_module_output_count(model->module_));
+        for (size_t i = 0; ok && i < model->inputs_.size(); i++) {
+            ok = check(et_module_input_spec(model->module_, static_cast<int32_t>(i), &model->inputs_[i]), error);
+        }
+        for (size_t i = 0; ok && i < model->outputs_.size(); i++) {
+            ok = check(et_module_output_spec(model->module_, static_cast<int32_t>(i), &model->outputs_[i]), error);
+        }
+        if (!ok) return nullptr;
+
+        if (config.batch > 1) {
+            auto batched = [&](const ETTensorSpec& spec) { return spec.rank > 0 && spec.shape[0] == config.batch; };
+            if (!std::all_of(model->inputs_.begin(), model->inputs_.end(), batched) ||
+                !std::all_of(model->outputs_.begin(), model->outputs_.end(), batched)) {
+                *error = "batch=" + std::to_string(config.batch) +
+                         " requires dim 0 of every input and output to be " + std::to_string(config.batch);
+                return nullptr;
+            }
+        }
+
+        model->worker_ = std::thread(&ServedModel::run, model.get());
+        return model;
+    }
+
+    ~ServedModel() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        queued_.notify_all();
+        if (worker_.joinable()) worker_.join();
+        for (auto& request : queue_) fail(*request, ET_INVALID_STATE, "server shutting down");
+        et_module_free(module_);
+    }
+
+    // Validates and queues a request; takes ownership of the inputs
+    std::future<Reply> submit(std::vector<ETTensor*> inputs) {
+        auto request = std::make_unique<Request>();
+        request->inputs = std::move(inputs);
+        request->enqueued = Clock::now();
+        std::future<Reply> reply = request->reply.get_future();
+
+        std::string error = validate(*request);
+        std::lock_guard<std::mutex> lock(mutex_);
+        metrics_.requests++;
+        if (!error.empty()) {
+            metrics_.errors++;
+            fail(*request, ET_INVALID_ARGUMENT, error);
+            return reply;
+        }
+        queue_.push_back(std::move(request));
+        queued_.notify_one();
+        return reply;
+    }
+
+    void describe(std::string* out) const {
+        auto specs = [](const std::vector<ETTensorSpec>& list) {
+            std::string text;
+            for (const auto& spec : list) {
+                if (!text.empty()) text += ",";
+                text += dtype_name(spec.dtype);
+                text += "[";
+                for (int32_t d = 0; d < spec.rank; d++) {
+                    text += (d ? "," : "") + std::to_string(spec.shape[d]);
+                }
+                text += "]";
+            }
+            return text;
+        };
+        *out += config_.name + " inputs=" + specs(inputs_) + " outputs=" + specs(outputs_) +
+                " batch=" + std::to_string(config_.batch) + "\n";
+    }
+
+    void metrics(std::string* out, const char* family) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::string label = "{model=\"" + config_.name + "\"";
+        char line[256];
+        auto counter = [&](const char* name, uint64_t value) {
+            if (strcmp(family, name) == 0) {
+                snprintf(line, sizeof(line), "%s%s} %llu\n", name, label.c_str(),
+                         static_cast<unsigned long long>(value));
+                *out += line;
+            }
+        };
+        auto summary = [&](const char* name, const LatencyWindow& window) {
+            if (strcmp(family, name) != 0) return;
+            for (double q : {0.5, 0.9, 0.99}) {
+                snprintf(line, sizeof(line), "%s%s,quantile=\"%g\"} %.3f\n", name, label.c_str(), q,
+                         window.percentile(q));
+                *out += line;
+            }
+        };
+        counter("et_serve_requests_total", metrics_.requests);
+        counter("et_serve_errors_total", metrics_.errors);
+        counter("et_serve_batches_total", metrics_.batches);
+        counter("et_serve_batch_rows_total", metrics_.batch_rows);
+        summary("et_serve_queue_ms", metrics_.queue_ms);
+        summary("et_serve_inference_ms", metrics_.inference_ms);
+    }
+
+private:
+    explicit ServedModel(const ModelConfig& config) : config_(config) {}
+
+    std::string validate(Request& request) const {
+        if (request.inputs.size() != inputs_.size()) {
+            return "expected " + std::to_string(inputs_.size()) + " inputs, got " +
+                   std::to_string(request.inputs.size());
+        }
+        for (size_t i = 0; i < inputs_.size(); i++) {
+            const ETTensor* tensor = request.inputs[i];
+            const ETTensorSpec& spec = inputs_[i];
+            int32_t rank = et_tensor_rank(tensor);
+            const int64_t* shape = et_tensor_shape(tensor);
+            if (et_tensor_dtype(tensor) != spec.dtype || rank != spec.rank) {
+                return "input " + std::to_string(i) + ": expected " + dtype_name(spec.dtype) + " of rank " +
+                       std::to_string(spec.rank);
+            }
+            if (config_.batch == 1) continue;  // Runtime checks shapes
+            if (i == 0) request.rows = shape[0];
+            if (shape[0] != request.rows || shape[0] > config_.batch) {
+                return "input " + std::to_string(i) + ": dim 0 must match across inputs and be at most " +
+                       std::to_string(config_.batch);
+            }
+            for (int32_t d = 1; d < rank; d++) {
+                if (shape[d] != spec.shape[d]) {
+                    return "input " + std::to_string(i) + ": dim " + std::to_string(d) + " must be " +
+                           std::to_string(spec.shape[d]);
+                }
+            }
+        }
+        return "";
+    }
+
+    static void fail(Request& request, int32_t code, const std::string& message) {
+        Reply reply;
+        reply.code = code;
+        reply.message = message;
+        request.reply.set_value(std::move(reply));
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            queued_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+            if (stopping_) return;
+
+            // Gather requests until the batch is full or the first one has
+            // waited wait_us
+            std::vector<std::unique_ptr<Request>> group;
+            int64_t rows = 0;
+            auto deadline = queue_.front()->enqueued + std::chrono::microseconds(config_.wait_us);
+            while (true) {
+                if (!queue_.empty()) {
+                    if (!group.empty() && rows + queue_.front()->rows > config_.batch) break;
+                    rows += queue_.front()->rows;
+                    group.push_back(std::move(queue_.front()));
+                    queue_.pop_front();
+                    if (config_.batch == 1 || rows == config_.batch) break;
+                    continue;
+                }
+                if (queued_.wait_until(lock, deadline) == std::cv_status::timeout || stopping_) {
+                    if (queue_.empty()) break;
+                }
+            }
+
+            lock.unlock();
+            execute(group, rows);
+            lock.lock();
+        }
+    }
+
+    // Runs one forward call for the group and answers every request in it
+    void execute(std::vector<std::unique_ptr<Request>>& group, int64_t rows) {
+        auto start = Clock::now();
+        int64_t batch_rows = config_.batch > 1 && config_.pad ? config_.batch : rows;
+        bool direct = group.size() == 1 && (config_.batch == 1 || rows == batch_rows);
+
+        // Concatenate the requests' inputs along dim 0 (zero padding after)
+        std::vector<ETTensor*> inputs;
+        std::vector<ETTensor*> combined;
+        std::string error;
+        if (direct) {
+            inputs = group[0]->inputs;
+        } else {
+            for (size_t i = 0; i < inputs_.size(); i++) {
+                const ETTensorSpec& spec = inputs_[i];
+                std::vector<int64_t> shape(spec.shape, spec.shape + spec.rank);
+                shape[0] = batch_rows;
+                ETTensor* tensor = nullptr;
+                if (!check(et_tensor_create(nullptr, spec.nbytes / spec.shape[0] * batch_rows, shape.data(),
+                                            spec.rank, spec.dtype, &tensor), &error)) {
+                    break;
+                }
+                combined.push_back(tensor);
+                uint8_t* dst = static_cast<uint8_t*>(et_tensor_mutable_data(tensor));
+                for (const auto& request : group) {
+                    size_t size = et_tensor_data_size(request->inputs[i]);
+                    memcpy(dst, et_tensor_data(request->inputs[i]), size);
+                    dst += size;
+                }
+            }
+            inputs = combined;
+        }
+
+        ETTensor** outputs = nullptr;
+        int32_t output_count = 0;
+        if (error.empty()) {
+            check(et_module_forward(module_, inputs.data(), static_cast<int32_t>(inputs.size()),
+                                    &outputs, &output_count), &error);
+        }
+        for (ETTensor* tensor : combined) et_tensor_free(tensor);
+        double inference_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        // Split the outputs back per request
+        std::vector<Reply> replies(group.size());
+        if (error.empty() && direct) {
+            replies[0].outputs.assign(outputs, outputs + output_count);
+            et_tensor_array_release(outputs);
+            outputs = nullptr;
+        } else if (error.empty()) {
+            for (int32_t o = 0; o < output_count && error.empty(); o++) {
+                int32_t rank = et_tensor_rank(outputs[o]);
+                const int64_t* shape = et_tensor_shape(outputs[o]);
+                if (rank < 1 || shape[0] != batch_rows) {
+                    error = "output " + std::to_string(o) + " is not batched along dim 0";
+                    break;
+                }
+                size_t row_size = et_tensor_data_size(outputs[o]) / static_cast<size_t>(batch_rows);
+                const uint8_t* src = static_cast<const uint8_t*>(et_tensor_data(outputs[o]));
+                std::vector<int64_t> part_shape(shape, shape + rank);
+                for (size_t r = 0; r < group.size() && error.empty(); r++) {
+                    part_shape[0] = group[r]->rows;
+                    size_t size = row_size * static_cast<size_t>(group[r]->rows);
+                    ETTensor* part = nullptr;
+                    if (check(et_tensor_create(src, size, part_shape.data(), rank, et_tensor_dtype(outputs[o]),
+                                               &part), &error)) {
+                        replies[r].outputs.push_back(part);
+                    }
+                    src += size;
+                }
+            }
+        }
+        if (outputs) et_tensor_array_free(outputs, output_count);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        metrics_.batches++;
+        metrics_.batch_rows += static_cast<uint64_t>(rows);
+        metrics_.inference_ms.record(inference_ms);
+        for (size_t r = 0; r < group.size(); r++) {
+            metrics_.queue_ms.record(std::chrono::duration<double, std::milli>(start - group[r]->enqueued).count());
+            if (!error.empty()) {
+                for (ETTensor* tensor : replies[r].outputs) et_tensor_free(tensor);
+                metrics_.errors++;
+                fail(*group[r], ET_INFERENCE_FAILED, error);
+            } else {
+                group[r]->reply.set_value(std::move(replies[r]));
+            }
+        }
+    }
+
+    ModelConfig config_;
+    ETModule* module_ = nullptr;
+    std::vector<ETTensorSpec> inputs_;
+    std::vector<ETTensorSpec> outputs_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable queued_;
+    std::deque<std::unique_ptr<Request>> queue_;
+    bool stopping_ = false;
+    ModelMetrics metrics_;
+    std::thread worker_;
+};
+
+/* ============================================================================
+ * Framing
+ * ============================================================================ */
+
+bool read_full(int fd, void* data, size_t size) {
+    uint8_t* p = static_cast<uint8_t*>(data);
+    while (size > 0) {
+        ssize_t n = read(fd, p, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool write_full(int fd, const void* data, size_t size) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        ssize_t n = send(fd, p, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Reads one frame; fds that came with it are appended to *fds (caller closes)
+bool recv_frame(int fd, ETServeHeader* header, std::vector<uint8_t>* payload, std::vector<int>* fds) {
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int) * ET_SERVE_MAX_FDS)];
+    struct iovec iov = {header, sizeof(*header)};
+    struct msghdr message = {};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    ssize_t n;
+    do {
+#ifdef MSG_CMSG_CLOEXEC
+        n = recvmsg(fd, &message, MSG_CMSG_CLOEXEC);
+#else
+        n = recvmsg(fd, &message, 0);
+#endif
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) return false;
+
+    for (struct cmsghdr* c = CMSG_FIRSTHDR(&message); c; c = CMSG_NXTHDR(&message, c)) {
+        if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_RIGHTS) {
+            size_t count = (c->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            const int* received = reinterpret_cast<const int*>(CMSG_DATA(c));
+            fds->insert(fds->end(), received, received + count);
+        }
+    }
+    if ((message.msg_flags & MSG_CTRUNC) ||
+        !read_full(fd, reinterpret_cast<uint8_t*>(header) + n, sizeof(*header) - static_cast<size_t>(n))) {
+        return false;
+    }
+    if (header->magic != ET_SERVE_MAGIC || header->version != ET_SERVE_VERSION ||
+        header->payload_size > ET_SERVE_MAX_PAYLOAD) {
+        return false;
+    }
+    payload->resize(header->payload_size);
+    return read_full(fd, payload->data(), payload->size());
+}
+
+bool send_frame(int fd, const ETServeHeader& header, const std::vector<uint8_t>& payload,
+                const std::vector<int>& fds) {
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int) * ET_SERVE_MAX_FDS)];
+    struct iovec iov[2] = {{const_cast<ETServeHeader*>(&header), sizeof(header)},
+                           {const_cast<uint8_t*>(payload.data()), payload.size()}};
+    struct msghdr message = {};
+    message.msg_iov = iov;
+    message.msg_iovlen = 2;
+    if (!fds.empty()) {
+        message.msg_control = control;
+        message.msg_controllen = CMSG_SPACE(sizeof(int) * fds.size());
+        struct cmsghdr* c = CMSG_FIRSTHDR(&message);
+        c->cmsg_level = SOL_SOCKET;
+        c->cmsg_type = SCM_RIGHTS;
+        c->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+        memcpy(CMSG_DATA(c), fds.data(), sizeof(int) * fds.size());
+    }
+
+    ssize_t n;
+    do {
+        n = sendmsg(fd, &message, MSG_NOSIGNAL);
+    } while (n < 0 && errno == EINTR);
+    if (n < 0) return false;
+
+    // Rest of a partial write, without the fds (already sent)
+    size_t sent = static_cast<size_t>(n);
+    if (sent < sizeof(header)) {
+        if (!write_full(fd, reinterpret_cast<const uint8_t*>(&header) + sent, sizeof(header) - sent)) return false;
+        sent = sizeof(header);
+    }
+    sent -= sizeof(header);
+    return write_full(fd, payload.data() + sent, payload.size() - sent);
+}
+
+class Reader {
+public:
+    Reader(const std::vector<uint8_t>& data) : p_(data.data()), left_(data.size()) {}
+
+    const uint8_t* take(size_t size) {
+        size_t padded = (size + 7) & ~size_t(7);
+        if (padded > left_) padded = size;  // Final field may be unpadded
+        if (size > left_) return nullptr;
+        const uint8_t* data = p_;
+        p_ += padded;
+        left_ -= padded;
+        return data;
+    }
+
+    template <typename T>
+    bool read(T* out) {
+        const uint8_t* data = take(sizeof(T));
+        if (data) memcpy(out, data, sizeof(T));
+        return data != nullptr;
+    }
+
+private:
+    const uint8_t* p_;
+    size_t left_;
+};
+
+void append(std::vector<uint8_t>* out, const void* data, size_t size) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    out->insert(out->end(), p, p + size);
+    out->resize((out->size() + 7) & ~size_t(7), 0);
+}
+
+/* ============================================================================
+ * Server
+ * ============================================================================ */
+
+class Server {
+public:
+    explicit Server(Config config) : config_(std::move(config)) {}
+
+    bool load_models() {
+        for (const auto& model_config : config_.models) {
+            std::string error;
+            auto start = Clock::now();
+            auto model = ServedModel::load(model_config, &error);
+            if (!model) {
+                fprintf(stderr, "et_serve: %s (%s): %s\n", model_config.name.c_str(),
+                        model_config.path.c_str(), error.c_str());
+                return false;
+            }
+            fprintf(stderr, "et_serve: loaded %s in %.1f ms\n", model_config.name.c_str(),
+                    std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+            models_[model_config.name] = std::move(model);
+        }
+        return true;
+    }
+
+    int run() {
+        int listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        struct sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        if (listen_fd < 0 || config_.socket_path.size() >= sizeof(address.sun_path)) {
+            fprintf(stderr, "et_serve: invalid socket path %s\n", config_.socket_path.c_str());
+            return 1;
+        }
+        strncpy(address.sun_path, config_.socket_path.c_str(), sizeof(address.sun_path) - 1);
+
+        // Replace a stale socket left by a previous run
+        struct stat info;
+        if (lstat(config_.socket_path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+            unlink(config_.socket_path.c_str());
+        }
+        if (bind(listen_fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(listen_fd, 64) != 0) {
+            fprintf(stderr, "et_serve: cannot listen on %s: %s\n", config_.socket_path.c_str(), strerror(errno));
+            close(listen_fd);
+            return 1;
+        }
+        fprintf(stderr, "et_serve: serving %zu model(s) on %s\n", models_.size(), config_.socket_path.c_str());
+
+        while (!g_stop) {
+            struct pollfd poll_fd = {listen_fd, POLLIN, 0};
+            if (poll(&poll_fd, 1, 200) <= 0) continue;
+            int fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd < 0) continue;
+
+            std::lock_guard<std::mutex> lock(connections_mutex_);
+            connections_.push_back(fd);
+            std::thread(&Server::serve_connection, this, fd).detach();
+        }
+
+        close(listen_fd);
+        unlink(config_.socket_path.c_str());
+        {
+            // Unblock connection threads waiting in recv, then wait for them
+            std::unique_lock<std::mutex> lock(connections_mutex_);
+            for (int fd : connections_) shutdown(fd, SHUT_RDWR);
+            connections_closed_.wait(lock, [&] { return connections_.empty(); });
+        }
+        models_.clear();
+        fprintf(stderr, "et_serve: stopped\n");
+        return 0;
+    }
+
+private:
+    void serve_connection(int fd) {
+        ETServeHeader header;
+        std::vector<uint8_t> payload;
+        std::vector<int> fds;
+        while (!g_stop && recv_frame(fd, &header, &payload, &fds)) {
+            Reply reply;
+            bool shared_outputs = false;
+            if (header.op == ET_SERVE_OP_INFER) {
+                reply = infer(payload, &fds, &shared_outputs);
+            } else if (header.op == ET_SERVE_OP_METRICS) {
+                reply.message = metrics_text();
+            } else if (header.op == ET_SERVE_OP_MODELS) {
+                for (const auto& entry : models_) entry.second->describe(&reply.message);
+            } else {
+                reply.code = ET_UNSUPPORTED;
+                reply.message = "unknown op";
+            }
+            for (int received : fds) close(received);
+            fds.clear();
+
+            bool sent = respond(fd, header, reply, shared_outputs);
+            for (ETTensor* tensor : reply.outputs) et_tensor_free(tensor);
+            if (!sent) break;
+        }
+        for (int received : fds) close(received);
+
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        connections_.erase(std::find(connections_.begin(), connections_.end(), fd));
+        close(fd);
+        connections_closed_.notify_all();
+    }
+
+    Reply infer(const std::vector<uint8_t>& payload, std::vector<int>* fds, bool* shared_outputs) {
+        Reply reply;
+        reply.code = ET_INVALID_ARGUMENT;
+
+        Reader reader(payload);
+        ETServeInferRequest request;
+        const uint8_t* name = nullptr;
+        if (!reader.read(&request) || !(name = reader.take(request.model_len))) {
+            reply.message = "malformed request";
+            return reply;
+        }
+        auto model = models_.find(std::string(reinterpret_cast<const char*>(name), request.model_len));
+        if (model == models_.end()) {
+            reply.message = "unknown model";
+            return reply;
+        }
+        *shared_outputs = (request.flags & ET_SERVE_SHARED_OUTPUTS) != 0;
+
+        std::vector<ETTensor*> inputs;
+        size_t next_fd = 0;
+        for (uint16_t i = 0; i < request.tensor_count && reply.message.empty(); i++) {
+            ETServeTensor tensor;
+            const uint8_t* shape = nullptr;
+            if (!reader.read(&tensor) || tensor.rank > ET_MAX_RANK ||
+                !(shape = reader.take(sizeof(int64_t) * tensor.rank))) {
+                reply.message = "malformed tensor";
+                break;
+            }
+            int64_t dims[ET_MAX_RANK];
+            memcpy(dims, shape, sizeof(int64_t) * tensor.rank);
+
+            ETTensor* input = nullptr;
+            const uint8_t* data = nullptr;
+            std::string error;
+            bool ok;
+            if (tensor.location == ET_SERVE_SHARED && next_fd < fds->size()) {
+                ok = check(et_tensor_import_shared((*fds)[next_fd++], dims, tensor.rank,
+                                                   static_cast<ETDType>(tensor.dtype), &input), &error);
+            } else if (tensor.location == ET_SERVE_INLINE && (data = reader.take(tensor.nbytes))) {
+                ok = check(et_tensor_create(data, tensor.nbytes, dims, tensor.rank,
+                                            static_cast<ETDType>(tensor.dtype), &input), &error);
+            } else {
+                ok = false;
+                error = "malformed tensor";
+            }
+            if (ok) {
+                inputs.push_back(input);
+            } else {
+                reply.message = "input " + std::to_string(i) + ": " + error;
+            }
+        }
+        if (!reply.message.empty()) {
+            for (ETTensor* input : inputs) et_tensor_free(input);
+            return reply;
+        }
+        return model->second->submit(std::move(inputs)).get();
+    }
+
+    bool respond(int fd, const ETServeHeader& request, Reply& reply, bool shared_outputs) {
+        std::vector<int> fds;
+        std::vector<ETTensor*> shared;
+
+        // Outputs are copied once into fresh shared memory for the client
+        auto share_outputs = [&]() {
+            for (ETTensor* output : reply.outputs) {
+                ETTensor* copy = nullptr;
+                std::string error;
+                if (fds.size() == ET_SERVE_MAX_FDS ||
+                    !check(et_tensor_create_shared(et_tensor_shape(output), et_tensor_rank(output),
+                                                   et_tensor_dtype(output), &copy), &error)) {
+                    for (ETTensor* tensor : shared) et_tensor_free(tensor);
+                    shared.clear();
+                    fds.clear();
+                    return false;
+                }
+                memcpy(et_tensor_mutable_data(copy), et_tensor_data(output), et_tensor_data_size(output));
+                shared.push_back(copy);
+                fds.push_back(et_tensor_shared_fd(copy));
+            }
+            return true;
+        };
+
+        bool ok = reply.code == ET_OK;
+        if (shared_outputs && ok) shared_outputs = share_outputs();  // Falls back to inline
+        std::vector<uint8_t> payload = encode_response(reply.code, reply.message, reply.outputs, shared_outputs);
+
+        // Frames are capped at ET_SERVE_MAX_PAYLOAD: large inline outputs move
+        // to shared memory, anything else that does not fit becomes an error
+        if (payload.size() > ET_SERVE_MAX_PAYLOAD && ok && !shared_outputs && share_outputs()) {
+            shared_outputs = true;
+            payload = encode_response(reply.code, reply.message, reply.outputs, shared_outputs);
+        }
+        if (payload.size() > ET_SERVE_MAX_PAYLOAD) {
+            for (ETTensor* tensor : shared) et_tensor_free(tensor);
+            shared.clear();
+            fds.clear();
+            payload = encode_response(ET_UNSUPPORTED, "response exceeds the maximum frame size", {}, false);
+        }
+
+        ETServeHeader header = request;
+        header.payload_size = static_cast<uint32_t>(payload.size());
+        bool sent = send_frame(fd, header, payload, fds);
+        for (ETTensor* tensor : shared) et_tensor_free(tensor);
+        return sent;
+    }
+
+    static std::vector<uint8_t> encode_response(int32_t code, const std::string& message,
+                                                const std::vector<ETTensor*>& outputs, bool shared_outputs) {
+        std::vector<uint8_t> payload;
+        ETServeResponse response = {};
+        response.code = code;
+        response.message_len = static_cast<uint32_t>(std::min<size_t>(message.size(), ET_SERVE_MAX_PAYLOAD));
+        response.tensor_count = static_cast<uint16_t>(outputs.size());
+        append(&payload, &response, sizeof(response));
+        append(&payload, message.data(), response.message_len);
+        for (ETTensor* output : outputs) {
+            ETServeTensor tensor = {};
+            tensor.dtype = static_cast<uint8_t>(et_tensor_dtype(output));
+            tensor.rank = static_cast<uint8_t>(et_tensor_rank(output));
+            tensor.location = shared_outputs ? ET_SERVE_SHARED : ET_SERVE_INLINE;
+            tensor.nbytes = et_tensor_data_size(output);
+            append(&payload, &tensor, sizeof(tensor));
+            append(&payload, et_tensor_shape(output), sizeof(int64_t) * tensor.rank);
+            if (!shared_outputs) append(&payload, et_tensor_data(output), tensor.nbytes);
+        }
+        return payload;
+    }
+
+    std::string metrics_text() const {
+        std::string text;
+        static const char* counters[] = {"et_serve_requests_total", "et_serve_errors_total",
+                                         "et_serve_batches_total", "et_serve_batch_rows_total"};
+        static const char* summaries[] = {"et_serve_queue_ms", "et_serve_inference_ms"};
+        for (const char* family : counters) {
+            text += std::string("# TYPE ") + family + " counter\n";
+            for (const auto& entry : models_) entry.second->metrics(&text, family);
+        }
+        for (const char* family : summaries) {
+            text += std::string("# TYPE ") + family + " summary\n";
+            for (const auto& entry : models_) entry.second->metrics(&text, family);
+        }
+        text += "# TYPE et_serve_connections gauge\n";
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        text += "et_serve_connections " + std::to_string(connections_.size()) + "\n";
+        return text;
+    }
+
+    Config config_;
+    std::map<std::string, std::unique_ptr<ServedModel>> models_;  // Fixed after load_models()
+
+    // Open connections, each served by a detached thread
+    mutable std::mutex connections_mutex_;
+    std::condition_variable connections_closed_;
+    std::vector<int> connections_;
+};
+
+void usage() {
+    fprintf(stderr, "usage: et_serve --config FILE [--socket PATH] [--debug]\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const char* config_path = nullptr;
+    const char* socket_path = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--config") == 0 && i + 1 < argc) config_path = argv[++i];
+        else if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) socket_path = argv[++i];
+        else if (strcmp(argv[i], "--debug") == 0) et_set_debug_enabled(1);
+        else {
+            usage();
+            return 2;
+        }
+    }
+    if (!config_path) {
+        usage();
+        return 2;
+    }
+
+    Config config;
+    std::string error;
+    if (!parse_config(config_path, &config, &error)) {
+        fprintf(stderr, "et_serve: %s\n", error.c_str());
+        return 1;
+    }
+    if (socket_path) config.socket_path = socket_path;
+
+    struct sigaction action = {};
+    action.sa_handler = on_signal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    Server server(std::move(config));
+    if (!server.load_models()) return 1;
+    return server.run();
+}
@@ -0,0 +1,93 @@
+/**
+ * @file et_serve_protocol.h
+ * @brief Wire format of the et_serve Unix-socket inference daemon
+ *
+ * Clients connect to et_serve's SOCK_STREAM Unix socket and exchange frames:
+ * an ETServeHeader followed by header.payload_size bytes. Every request gets
+ * exactly one response frame with the same op and request_id, in order.
+ * All integers are in host byte order (client and server share the machine).
+ *
+ * INFER request payload:
+ *   ETServeInferRequest
+ *   char  model[model_len]            (no terminator), zero-padded to 8
+ *   tensor_count x tensor
+ *
+ * Response payload (every op):
+ *   ETServeResponse
+ *   char  message[message_len]        error text, metrics / model list text
+ *                                     for METRICS / MODELS; zero-padded to 8
+ *   tensor_count x tensor             (INFER outputs)
+ *
+ * Frames never exceed ET_SERVE_MAX_PAYLOAD. INFER outputs too large to send
+ * inline are returned as shared-memory tensors even without
+ * ET_SERVE_SHARED_OUTPUTS; a response that still does not fit is replaced
+ * by an ET_UNSUPPORTED error.
+ *
+ * Tensor:
+ *   ETServeTensor
+ *   int64_t shape[rank]
+ *   uint8_t data[nbytes], zero-padded to 8   (ET_SERVE_INLINE only)
+ *
+ * Shared-memory tensors (ET_SERVE_SHARED) carry no data in the frame: their
+ * file descriptors travel as SCM_RIGHTS ancillary data attached to the
+ * frame's header bytes - send the header and the fds in the same sendmsg()
+ * call - one fd per shared tensor, in tensor order. See
+ * et_tensor_create_shared() / et_tensor_import_shared() for creating and
+ * mapping them. The receiver owns (and closes) the fds it gets.
+ */
+
+#ifndef ET_SERVE_PROTOCOL_H
+#define ET_SERVE_PROTOCOL_H
+
+#include <stdint.h>
+
+#define ET_SERVE_MAGIC 0x56535445u  /* "ETSV" */
+#define ET_SERVE_VERSION 2
+#define ET_SERVE_MAX_FDS 64         /* Shared tensors per frame */
+#define ET_SERVE_MAX_PAYLOAD (1u << 30)
+
+typedef enum {
+    ET_SERVE_OP_INFER = 1,    /* Run a model's forward method */
+    ET_SERVE_OP_METRICS = 2,  /* Metrics text (Prometheus exposition format) */
+    ET_SERVE_OP_MODELS = 3    /* Loaded models and their I/O specs, one per line */
+} ETServeOp;
+
+typedef struct {
+    uint32_t magic;         /* ET_SERVE_MAGIC */
+    uint16_t version;       /* ET_SERVE_VERSION */
+    uint16_t op;            /* ETServeOp */
+    uint32_t request_id;    /* Caller's value, echoed in the response */
+    uint32_t payload_size;  /* Bytes following the header */
+} ETServeHeader;
+
+/* INFER flags */
+#define ET_SERVE_SHARED_OUTPUTS 0x1u  /* Return outputs as shared-memory tensors */
+
+typedef struct {
+    uint16_t model_len;
+    uint16_t tensor_count;
+    uint32_t flags;         /* ET_SERVE_* flags */
+} ETServeInferRequest;
+
+typedef struct {
+    int32_t code;           /* ETErrorCode */
+    uint32_t message_len;
+    uint16_t tensor_count;
+    uint16_t reserved;
+    uint32_t reserved2;
+} ETServeResponse;
+
+/* Tensor locations */
+#define ET_SERVE_INLINE 0     /* Data follows in the frame */
+#define ET_SERVE_SHARED 1     /* Data in the next SCM_RIGHTS fd */
+
+typedef struct {
+    uint8_t dtype;          /* ETDType */
+    uint8_t rank;           /* <= ET_MAX_RANK */
+    uint8_t location;       /* ET_SERVE_INLINE / ET_SERVE_SHARED */
+    uint8_t reserved;
+    uint32_t reserved2;
+    uint64_t nbytes;        /* Data size (shape x dtype) */
+} ETServeTensor;
+
+#endif /* ET_SERVE_PROTOCOL_H */